@@ -10,11 +10,23 @@ CONFIG += c++17 cmdline
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+        accountledger.cpp \
         accountserver.cpp \
         alphacalculator.cpp \
+        analyticsengine.cpp \
+        engineshard.cpp \
+        exposurebook.cpp \
+        instrumenttable.cpp \
         main.cpp \
+        marketdatafeed.cpp \
+        orderthrottle.cpp \
+        positionstore.cpp \
+        riskgate.cpp \
         trade.cpp \
-        tradeserver.cpp
+        tradejournal.cpp \
+        tradeserver.cpp \
+        tradewriter.cpp \
+        triggerbook.cpp
 
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
@@ -23,8 +35,29 @@ else: unix:!android: target.path = /opt/$${TARGET}/bin
 
 HEADERS += \
     DatabaseManager.h \
+    accountevent.h \
+    accountledger.h \
     accountserver.h \
     alphacalculator.h \
+    analyticsengine.h \
     asset.h \
+    engineshard.h \
+    exposurebook.h \
+    instrumenttable.h \
+    klinedecoder.h \
+    marketcapture.h \
+    marketdatafeed.h \
+    objectpool.h \
+    orderthrottle.h \
+    positionstore.h \
+    riskgate.h \
+    riskverdict.h \
+    spscring.h \
     trade.h \
-    tradeserver.h
+    tradeevent.h \
+    tradejournal.h \
+    tradeid.h \
+    tradeserver.h \
+    tradewriter.h \
+    triggerbook.h \
+    wireprotocol.h
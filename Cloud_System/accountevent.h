@@ -0,0 +1,101 @@
+/* =========================================================================
+   AccountEvent.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   The events AccountServer pushes to account views, and the per‑user
+   fan‑out that delivers them.
+
+   Key features
+   • AccountEvent::equity / tradeClosed / alphaUpdated / accountLocked
+     build one event in both formats side by side: the JSON object and
+     the WireProtocol frame.
+   • AccountEvent::fanOut sends an event to every socket of one user in
+     the format that socket negotiated. The JSON text is serialised at most
+     once per event and the binary frame is shared by all sockets.
+
+   Design notes
+   • Header‑only and templated on the socket type. AccountServer passes
+     QWebSocket; cloud_bench passes a stand‑in socket, so it measures this
+     exact code without a server, a port or a database.
+   • Qt‑core only – no QtWebSockets dependency.
+   ========================================================================= */
+
+#ifndef ACCOUNTEVENT_H
+#define ACCOUNTEVENT_H
+
+#include "tradeevent.h"
+#include "wireprotocol.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMap>
+#include <QSet>
+
+struct AccountEvent {
+    QJsonObject json;                 // for JSON sockets
+    QByteArray  binary;               // WireProtocol frame for binary sockets
+
+    static AccountEvent equity(double equity){
+        QJsonObject o;  o["type"] = "equity";  o["equityUpdate"] = equity;
+        return { o, Wire::encodeEvent(Wire::Msg::Equity, equity) };
+    }
+
+    /* @p balance is the account balance after the close. */
+    static AccountEvent tradeClosed(const TradeEvent &e, double balance){
+        Wire::TradeClosed m;
+        m.balance    = balance;
+        m.tradeID    = e.tradeID;
+        m.asset      = static_cast<qint32>(e.asset);
+        m.size       = e.size;
+        m.openPrice  = e.openPrice;
+        m.closePrice = e.closePrice;
+        m.pnl        = e.pnl;
+        m.closedAtMs = e.at.toMSecsSinceEpoch();
+
+        QJsonObject t;
+        t["tradeID"]    = TradeIds::toString(e.tradeID);
+        t["asset"]      = m.asset;
+        t["size"]       = m.size;
+        t["openPrice"]  = m.openPrice;
+        t["closePrice"] = m.closePrice;
+        t["pnl"]        = m.pnl;
+        t["date"]       = e.at.toUTC().toString(Qt::ISODateWithMs);
+
+        QJsonObject o;  o["type"] = "tradeClosed";  o["balance"] = m.balance;
+        o["trade"] = t;
+        return { o, Wire::encode(m) };
+    }
+
+    static AccountEvent alphaUpdated(double alpha){
+        QJsonObject o;  o["type"] = "alphaUpdated";  o["alpha"] = alpha;
+        return { o, Wire::encodeEvent(Wire::Msg::AlphaUpdated, alpha) };
+    }
+
+    static AccountEvent accountLocked(){
+        QJsonObject o;  o["type"] = "accountLocked";
+        return { o, Wire::encodeEvent(Wire::Msg::AccountLocked) };
+    }
+
+    /* Send this event to every socket in @p sessions[userID]: the frame to
+       sockets in @p binarySockets, the compact JSON text to the rest. */
+    template <typename Socket>
+    void fanOut(const QMap<int, QList<Socket*>> &sessions,
+                const QSet<Socket*> &binarySockets, int userID) const{
+        const auto it = sessions.constFind(userID);
+        if (it == sessions.cend()) return;
+        QString msg;
+        for (Socket *s : it.value()) {
+            if (binarySockets.contains(s)) {
+                s->sendBinaryMessage(binary);
+            } else {
+                if (msg.isEmpty())
+                    msg = QJsonDocument(json).toJson(QJsonDocument::Compact);
+                s->sendTextMessage(msg);
+            }
+        }
+    }
+};
+
+#endif // ACCOUNTEVENT_H
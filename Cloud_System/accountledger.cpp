@@ -0,0 +1,154 @@
+/* =========================================================================
+   AccountLedger.cpp – implementation of AccountLedger.h
+   -------------------------------------------------------------------------
+   Startup load, in‑place updates and batched write‑behind for "Account".
+   ========================================================================= */
+
+#include "accountledger.h"
+#include "DatabaseManager.h"
+
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QtDebug>
+
+AccountLedger::AccountLedger(QObject *parent)
+    : QObject(parent)
+{
+    connect(&flushTimer, &QTimer::timeout, this, &AccountLedger::flush);
+    flushTimer.start(FLUSH_MS);
+    clock.start();
+}
+
+AccountLedger::~AccountLedger(){
+    flush();
+    if (!dirty.isEmpty())
+        qWarning() << "[AccountLedger]" << dirty.size()
+                   << "rows not written on shutdown";
+}
+
+bool AccountLedger::load(){
+    QSqlQuery q(DatabaseManager::getInstance().connection());
+    q.setForwardOnly(true);
+    if (!q.exec("SELECT user_id, balance, max_loss, alpha, status "
+                "FROM \"Account\"")) {
+        qWarning() << "[AccountLedger] load failed:" << q.lastError();
+        return false;
+    }
+    missing.clear();
+    while (q.next()) {
+        AccountRecord r;
+        r.balance = q.value(1).toDouble();
+        r.maxLoss = q.value(2).toDouble();
+        r.alpha   = q.value(3).toDouble();
+        r.active  = q.value(4).toBool();
+        accounts.insert(q.value(0).toInt(), r);
+    }
+    qDebug() << "[AccountLedger] loaded" << accounts.size() << "accounts";
+    return true;
+}
+
+/* Single‑row load for accounts created after startup ------------------- */
+bool AccountLedger::fetch(int uid){
+    QSqlQuery &q = DatabaseManager::getInstance().prepared(
+        "SELECT balance, max_loss, alpha, status "
+        "FROM \"Account\" WHERE user_id=:u");
+    q.bindValue(":u", uid);
+    if (!q.exec() || !q.next()) return false;
+
+    AccountRecord r;
+    r.balance = q.value(0).toDouble();
+    r.maxLoss = q.value(1).toDouble();
+    r.alpha   = q.value(2).toDouble();
+    r.active  = q.value(3).toBool();
+    accounts.insert(uid, r);
+    return true;
+}
+
+/* Misses (no row, or the query failed) are remembered for MISS_TTL_MS so
+   an unknown userID on the tick path does not cost a query every time. */
+AccountRecord *AccountLedger::find(int uid){
+    auto it = accounts.find(uid);
+    if (it != accounts.end()) return &it.value();
+
+    const qint64 now = clock.elapsed();
+    const auto m = missing.constFind(uid);
+    if (m != missing.cend() && now - m.value() < MISS_TTL_MS) return nullptr;
+
+    if (!fetch(uid)) {
+        if (missing.size() >= MISS_MAX) missing.clear();
+        missing.insert(uid, now);
+        return nullptr;
+    }
+    missing.remove(uid);
+    return &accounts[uid];
+}
+
+AccountRecord *AccountLedger::applyPnL(int uid, double pnl){
+    AccountRecord *r = find(uid);
+    if (!r) return nullptr;
+    r->balance += pnl;
+    dirty.insert(uid);
+    return r;
+}
+
+void AccountLedger::setBalance(int uid, double balance){
+    if (AccountRecord *r = find(uid)) { r->balance = balance; dirty.insert(uid); }
+}
+
+void AccountLedger::setAlpha(int uid, double alpha){
+    if (AccountRecord *r = find(uid)) { r->alpha = alpha; dirty.insert(uid); }
+}
+
+void AccountLedger::setActive(int uid, bool active){
+    if (AccountRecord *r = find(uid)) { r->active = active; dirty.insert(uid); }
+}
+
+/* ------------------------------------------------------------------------
+   Dirty rows → one transaction of UPDATE … FROM (VALUES …) chunks.
+   ------------------------------------------------------------------------ */
+void AccountLedger::flush(){
+    if (dirty.isEmpty()) return;
+
+    QSqlDatabase &db = DatabaseManager::getInstance().connection();
+    const QList<int> ids = dirty.values();
+
+    if (!db.transaction()) {
+        qWarning() << "[AccountLedger] BEGIN failed:" << db.lastError().text();
+        return;                                    // stay dirty, retry later
+    }
+
+    for (int from = 0; from < ids.size(); from += FLUSH_ROWS) {
+        const int n = qMin(FLUSH_ROWS, int(ids.size()) - from);
+
+        QStringList rows;
+        rows << QStringLiteral("(CAST(? AS integer),CAST(? AS float8),"
+                               "CAST(? AS float8),CAST(? AS boolean))");
+        for (int i = 1; i < n; ++i) rows << QStringLiteral("(?,?,?,?)");
+
+        QSqlQuery q(db);
+        q.prepare("UPDATE \"Account\" AS a SET "
+                  "balance = v.b, alpha = v.al, status = v.s "
+                  "FROM (VALUES " + rows.join(',') + ") AS v(u,b,al,s) "
+                  "WHERE a.user_id = v.u");
+        for (int i = from; i < from + n; ++i) {
+            const AccountRecord &r = accounts[ids[i]];
+            q.addBindValue(ids[i]);
+            q.addBindValue(r.balance);
+            q.addBindValue(r.alpha);
+            q.addBindValue(r.active);
+        }
+        if (!q.exec()) {
+            qWarning() << "[AccountLedger] flush failed:" << q.lastError();
+            db.rollback();
+            return;
+        }
+    }
+
+    if (!db.commit()) {
+        qWarning() << "[AccountLedger] COMMIT failed:" << db.lastError().text();
+        db.rollback();
+        return;
+    }
+    dirty.clear();
+}
@@ -0,0 +1,87 @@
+/* =========================================================================
+   AccountLedger.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Authoritative in‑memory copy of the "Account" table.
+
+   Key features
+   • Holds balance, max_loss, alpha and status for every account; loaded in
+     one SELECT at startup, so draw‑down checks are a hash lookup instead
+     of a query per user per tick.
+   • Mutations (trade close, lock, alpha) are applied in place and the row
+     is marked dirty; flush() writes every dirty row back in one
+     transaction (UPDATE … FROM (VALUES …)) every FLUSH_MS.
+   • Accounts created after startup are fetched on first use and cached.
+     Misses are remembered for MISS_TTL_MS, so an unknown userID costs
+     one query per TTL instead of one per tick; load() forgets them.
+
+   Design notes
+   • The Cloud is the only writer of these columns (the desktop client only
+     reads them), so the ledger can be authoritative and the DB lags by at
+     most FLUSH_MS.
+   • Rows are written as absolute values – a flush that fails leaves the
+     rows dirty and the next tick simply retries; nothing is double‑applied.
+   • Lives on AccountServer's thread; not thread‑safe.
+   • Shutdown calls flush() explicitly (AccountServer::flushLedger() from
+     main's aboutToQuit handler); the flush on destruction is only a
+     backstop and logs anything it still could not write.
+   ========================================================================= */
+
+#ifndef ACCOUNTLEDGER_H
+#define ACCOUNTLEDGER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+
+struct AccountRecord {
+    double balance = 0.0;
+    double maxLoss = 0.0;
+    double alpha   = 0.0;
+    bool   active  = true;     // "status" column
+};
+
+class AccountLedger : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int FLUSH_MS    = 1000;
+    static constexpr int FLUSH_ROWS  = 500;    // rows per UPDATE statement
+    static constexpr int MISS_TTL_MS = 5000;   // negative‑cache lifetime
+    static constexpr int MISS_MAX    = 4096;   // cap on remembered misses
+
+    explicit AccountLedger(QObject *parent = nullptr);
+    ~AccountLedger();
+
+    /* Load every account; call once before serving traffic. */
+    bool load();
+
+    /* Record for @p userID (fetched on a miss); nullptr if no such account
+       or the last fetch for it failed less than MISS_TTL_MS ago. */
+    AccountRecord *find(int userID);
+
+    /* Realised PnL lands on the balance. @return updated record or nullptr. */
+    AccountRecord *applyPnL  (int userID, double pnl);
+    void           setBalance(int userID, double balance);
+    void           setAlpha  (int userID, double alpha);
+    void           setActive (int userID, bool active);
+
+    int size()       const { return accounts.size(); }
+    int dirtyCount() const { return dirty.size(); }
+
+public slots:
+    /* Write every dirty row back to Postgres. */
+    void flush();
+
+private:
+    bool fetch(int userID);
+
+    QHash<int, AccountRecord> accounts;
+    QSet<int>                 dirty;
+    QHash<int, qint64>        missing;         // userID -> clock ms of miss
+    QElapsedTimer             clock;
+    QTimer                    flushTimer;
+};
+
+#endif // ACCOUNTLEDGER_H
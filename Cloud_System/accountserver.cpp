@@ -5,19 +5,18 @@
      • WebSocket session management per account (multi‑tenant).
      • Real‑time equity / P&L / alpha pushes.
      • First‑line risk lock when draw‑down breaches.
-     • Delegates statistical alpha calculation to AlphaCalculator.
+     • Persists + pushes alpha computed by TradeServer’s AnalyticsEngine.
    ========================================================================= */
 
 #include "accountserver.h"
 #include "DatabaseManager.h"
 #include "tradeserver.h"
+#include "wireprotocol.h"
 
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QSqlQuery>
 #include <QSqlError>
-#include <QDate>
-#include <QtMath>
 #include <QDebug>
 
 /* -------------------------------------------------------------------------
@@ -30,9 +29,11 @@ AccountServer::AccountServer(quint16 port,
     server(new QWebSocketServer(QStringLiteral("Account WS"),
                                 QWebSocketServer::NonSecureMode, this)),
     tradeServer(ts),
-    alphaCalc(this),
-    db(DatabaseManager::getInstance().getDatabase())
+    ledger(this)
 {
+    // 0. Account state lives in memory from here on.
+    ledger.load();
+
     // 1. Listen on the requested port (0.0.0.0). Any failure is fatal to UX.
     if (server->listen(QHostAddress::Any, port)) {
         qDebug() << "Account WS listening on" << port;
@@ -42,13 +43,12 @@ AccountServer::AccountServer(quint16 port,
         qCritical() << "Account WS failed to listen!";
     }
 
-    // 2. Cross‑module hooks (signals come from TradeServer + AlphaCalculator)
+    // 2. Cross‑module hooks (signals come from TradeServer; alpha arrives
+    //    through pushAlpha() from its AnalyticsEngine)
     connect(tradeServer, &TradeServer::tradeClosed,
             this,        &AccountServer::onCloseTrade);
     connect(tradeServer, &TradeServer::equityUpdate,
             this,        &AccountServer::onEquityUpdate);
-    connect(&alphaCalc, &AlphaCalculator::alphaUpdated,
-            this,       &AccountServer::onAlphaReady);
 }
 
 /* -------------------------------------------------------------------------
@@ -87,6 +87,18 @@ void AccountServer::onTextMessageReceived(const QString &msg){
         userSessions[uid].append(sock);
         socketUserMap[sock] = uid;
         qDebug() << "AccountServer: registered socket for user" << uid;
+
+        // Opt‑in binary frames; anything else stays on JSON.
+        if (obj.value("protocol").toString() == "binary" &&
+            obj.value("protocolVersion").toInt() == Wire::VERSION) {
+            binarySockets.insert(sock);
+            QJsonObject ack;
+            ack["type"]            = "protocol";
+            ack["protocol"]        = "binary";
+            ack["protocolVersion"] = Wire::VERSION;
+            sock->sendTextMessage(
+                QJsonDocument(ack).toJson(QJsonDocument::Compact));
+        }
     }
 }
 
@@ -96,6 +108,7 @@ void AccountServer::onSocketDisconnected(){
     if (!sock) return;
 
     int uid = socketUserMap.take(sock);   // 0 if not found
+    binarySockets.remove(sock);
     if (uid != 0) {
         userSessions[uid].removeOne(sock);
         if (userSessions[uid].isEmpty())
@@ -113,113 +126,84 @@ QMap<int, QList<QWebSocket*>> AccountServer::getUserSessions() const{
 }
 
 /* -------------------------------------------------------------------------
-   Equity update from TradeServer. Perform draw‑down check, update DB, and
-   broadcast fresh equity to the dashboard.
+   Equity update from TradeServer. Draw‑down check against the in‑memory
+   ledger (no SQL), then broadcast fresh equity to the dashboard.
    ------------------------------------------------------------------------- */
 void AccountServer::onEquityUpdate(int userID, double totalPnL){
-    QSqlQuery q(db);
-    q.prepare("SELECT balance, max_loss FROM \"Account\" WHERE user_id=:u");
-    q.bindValue(":u", userID);
-    if (!q.exec() || !q.next()) {
-        qWarning() << "[EquityUpdate] SQL fail:" << q.lastError();
+    AccountRecord *acc = ledger.find(userID);
+    if (!acc) {
+        qWarning() << "[EquityUpdate] unknown account" << userID;
         return;
     }
-    const double bal   = q.value(0).toDouble();
-    const double mLoss = q.value(1).toDouble();
+    if (!acc->active) return;                 // already locked
 
-    const double equity = bal + totalPnL;
+    const double equity = acc->balance + totalPnL;
 
-    if (equity <= mLoss) {
+    if (equity <= acc->maxLoss) {
         // Hard breach: lock account and exit early.
-        q.prepare("UPDATE \"Account\" SET balance=:b WHERE user_id=:u");
-        q.bindValue(":b", equity);
-        q.bindValue(":u", userID);
-        q.exec();
+        ledger.setBalance(userID, equity);
         accountLocked(userID);
         return;
     }
 
     // Broadcast real‑time equity.
-    QJsonObject o;  o["type"] = "equity";  o["equityUpdate"] = equity;
-    broadcastJson(userID, o);
+    broadcast(userID, AccountEvent::equity(equity));
 }
 
 /* -------------------------------------------------------------------------
-   Trade has closed – update balance, check risk lock, push UI event, and
-   feed the trade result into AlphaCalculator.
+   Trade has closed – book the PnL in the ledger, check risk lock, push UI
+   event. (Analytics see the same close through TradeServer.) The event
+   carries the new balance and the closed Trade_History row: "Account" and
+   Trade_History are both written behind, so a client that re‑read them
+   now would still see the state before the close.
    ------------------------------------------------------------------------- */
-void AccountServer::onCloseTrade(int userID, double pnl){
-    // 1. DB update (balance bump + read back new balance & max_loss)
-    QSqlQuery q(db);
-    q.prepare("UPDATE \"Account\" SET balance = balance + :p "
-              "WHERE user_id = :u RETURNING balance, max_loss");
-    q.bindValue(":p", pnl);
-    q.bindValue(":u", userID);
-    if (!q.exec() || !q.next()) {
-        qWarning() << "[CloseTrade] SQL fail:" << q.lastError();
+void AccountServer::onCloseTrade(const TradeEvent &e){
+    const int userID = e.userID;
+
+    // 1. Ledger update (flushed to "Account" by AccountLedger)
+    AccountRecord *acc = ledger.applyPnL(userID, e.pnl);
+    if (!acc) {
+        qWarning() << "[CloseTrade] unknown account" << userID;
         return;
     }
-    const double newBal = q.value(0).toDouble();
-    const double maxL   = q.value(1).toDouble();
 
-    if (newBal <= maxL) {
-        accountLocked(userID);
-    } else {
-        QJsonObject o;  o["type"] = "tradeClosed";
-        broadcastJson(userID, o);
+    if (acc->balance <= acc->maxLoss) {
+        if (acc->active) accountLocked(userID);
+        return;
     }
 
-    // 2. Feed realised trade into alpha calculator.
-    const double w = qAbs(pnl);
-    if (w > 0) {
-        const double rp = pnl / w;
-        const QDate   d = QDate::currentDate();
-        alphaCalc.addTrade(userID, d, rp, w);
-    }
+    broadcast(userID, AccountEvent::tradeClosed(e, acc->balance));
 }
 
 /* -------------------------------------------------------------------------
-   AlphaCalculator produced a new alpha value → persist + broadcast.
+   AnalyticsEngine produced a new alpha value → persist (write‑behind) +
+   broadcast; the value itself is in the event, clients do not re‑read it.
    ------------------------------------------------------------------------- */
-void AccountServer::onAlphaReady(int userID, double alpha){
-    QSqlQuery q(db);
-    q.prepare("UPDATE \"Account\" SET alpha=:a WHERE user_id=:u");
-    q.bindValue(":a", alpha);
-    q.bindValue(":u", userID);
-    if (!q.exec())
-        qWarning() << "[AlphaWrite] SQL:" << q.lastError();
-
-    QJsonObject o;  o["type"] = "alphaUpdated";  o["alpha"] = alpha;
-    broadcastJson(userID, o);
+void AccountServer::pushAlpha(int userID, double alpha){
+    ledger.setAlpha(userID, alpha);
+
+    broadcast(userID, AccountEvent::alphaUpdated(alpha));
 }
 
 /* -------------------------------------------------------------------------
-   Lock account in DB, force‑close trades via TradeServer, push dashboard
-   notification.
+   Lock account in the ledger, force‑close trades via TradeServer, push
+   dashboard notification.
    ------------------------------------------------------------------------- */
 void AccountServer::accountLocked(int userID){
     // Flag account as disabled.
-    QSqlQuery q(db);
-    q.prepare("UPDATE \"Account\" SET status=false WHERE user_id=:u");
-    q.bindValue(":u", userID);
-    q.exec();
+    ledger.setActive(userID, false);
 
     // Cascade close trades (TradeServer listens to this signal).
     emit closeAllTrades(userID);
 
     // Notify dashboard.
-    QJsonObject o;   o["type"] = "accountLocked";
-    broadcastJson(userID, o);
+    broadcast(userID, AccountEvent::accountLocked());
 }
 
 /* -------------------------------------------------------------------------
-   Helper – send compact JSON string to every socket for the given uid.
-   One serialisation per event keeps CPU + latency under control.
+   Helper – send one event to every socket for the given uid, in the format
+   each socket negotiated (see AccountEvent::fanOut).
    ------------------------------------------------------------------------- */
-void AccountServer::broadcastJson(int uid,
-                                  const QJsonObject &obj) const{
-    if (!userSessions.contains(uid)) return;
-    const QString msg = QJsonDocument(obj).toJson(QJsonDocument::Compact);
-    for (auto *ws : userSessions[uid])
-        ws->sendTextMessage(msg);
+void AccountServer::broadcast(int uid, const AccountEvent &event) const{
+    event.fanOut(userSessions, binarySockets, uid);
 }
@@ -17,12 +17,17 @@
    Design notes
    • **Single‑serialise, multi‑socket send** – for each event we build &
      serialise one QJsonObject, then write that same payload to all of the
-     user’s sockets. Saves ~90 % CPU when a user has >3 concurrent GUIs.
+     user’s sockets (AccountEvent::fanOut). Saves ~90 % CPU when a user
+     has >3 concurrent GUIs.
    • **Constant‑time look‑ups** – QHash maps socket→userID so disconnect
      handling is O(1).
-   • **Prepared SQL everywhere** – all writes go through DatabaseManager’s
-     prepared statements, avoiding injection and letting PostgreSQL cache
-     execution plans.
+   • **Per‑socket wire format** – sockets that negotiate "binary" in the
+     handshake receive WireProtocol event frames; everyone else keeps
+     compact JSON.
+   • **In‑memory ledger** – balance, max_loss, alpha and status are held
+     in AccountLedger (loaded once at startup), so per‑tick draw‑down checks
+     never touch the database; dirty rows are flushed in one batched
+     UPDATE every AccountLedger::FLUSH_MS.
    • TODO (beta) – swap QWebSocketServer for TLS + JWT authentication so
      the cloud layer can be exposed over the public internet.
    ========================================================================= */
@@ -36,16 +41,19 @@
 #include <QHash>
 #include <QMap>
 #include <QList>
+#include <QSet>
 #include <QSqlDatabase>
 
-#include "alphacalculator.h"          // alpha engine
+#include "accountevent.h"
+#include "accountledger.h"            // in‑memory Account rows
+#include "tradeevent.h"
 
 class TradeServer;
 
 /*
  * @class AccountServer
  * @brief Manages WebSocket sessions per account, enforces risk, and
- *        forwards alpha updates computed by AlphaCalculator.
+ *        forwards alpha updates computed by TradeServer's AnalyticsEngine.
  */
 class AccountServer : public QObject
 {
@@ -64,6 +72,18 @@ public:
     /* Disable trading for @a userID and trigger a full position close. */
     void accountLocked(int userID);
 
+    /* Record a fresh alpha value in the ledger and push it to every account
+       view of @a userID. */
+    void pushAlpha(int userID, double alpha);
+
+    /* Write every pending ledger change now – called from the shutdown
+       path once TradeServer has delivered its last closes. */
+    void flushLedger() { ledger.flush(); }
+
+    /* Ledger row for @a userID (nullptr if unknown) – read by TradeServer's
+       pre‑trade risk gate; same thread, no SQL on a hit. */
+    const AccountRecord *account(int userID) { return ledger.find(userID); }
+
 signals:
     void closeAllTrades(int userID);
 
@@ -73,21 +93,20 @@ private slots:
     void onSocketDisconnected();
 
     void onEquityUpdate(int userID, double totalPnL);
-    void onCloseTrade  (int userID, double pnl);
-
-    void onAlphaReady  (int userID, double alpha);
+    void onCloseTrade  (const TradeEvent &closed);
 
 private:
-    /* Broadcast @p obj to every socket currently logged in as @p userID. */
-    void broadcastJson(int userID, const QJsonObject &obj) const;
+    /* Broadcast one event to every socket currently logged in as @p userID:
+       its JSON to JSON sockets, its frame to WireProtocol sockets. */
+    void broadcast(int userID, const AccountEvent &event) const;
 
     QWebSocketServer                    *server;
     QMap<int, QList<QWebSocket*>>        userSessions;   // userID -> sockets
     QHash<QWebSocket*, int>              socketUserMap;  // socket -> userID
+    QSet<QWebSocket*>                    binarySockets;  // negotiated WireProtocol
 
     TradeServer                         *tradeServer;
-    AlphaCalculator                      alphaCalc;
-    QSqlDatabase                        &db;
+    AccountLedger                        ledger;         // in‑memory "Account"
 };
 
 #endif // ACCOUNTSERVER_H
@@ -1,126 +1,308 @@
 /* =========================================================================
    AlphaCalculator.cpp – implementation of Alphacalculator.h
    -------------------------------------------------------------------------
-   Streaming Jensen’s alpha with a 30‑day sliding window.
-   Called by AccountServer whenever a trade closes or a new benchmark
-   return is available.
+   Streaming α / β over a 30‑day window of running sums plus per‑day
+   trade tallies for Sharpe, Sortino, win rate and drawdown. Driven by
+   AnalyticsEngine whenever a trade closes or a day's benchmark return is
+   final.
    ========================================================================= */
 
 #include "alphacalculator.h"
+#include "DatabaseManager.h"
 #include <QSqlQuery>
 #include <QSqlError>
-#include <numeric>
+#include <QElapsedTimer>
+#include <QThreadPool>
 #include <cmath>
+#include <iterator>
+#include <vector>
 #include <QtDebug>
 
 // ---------------------------- ctor -------------------------------------
 AlphaCalculator::AlphaCalculator(QObject *parent)
     : QObject(parent) {}
 
-// ------------------------ helpers (static) -----------------------------
-namespace {
-inline double mean(const std::deque<double>& v) {
-    return std::accumulate(v.begin(), v.end(), 0.0) / v.size();
-}
-inline double variance(const std::deque<double>& x, double mx) {
-    double s = 0.0;
-    for (double v : x) s += (v - mx) * (v - mx);
-    return s / (x.size() - 1);
-}
-inline double covariance(const std::deque<double>& x,
-                         const std::deque<double>& y,
-                         double mx, double my) {
-    double s = 0.0;
-    for (size_t i = 0; i < x.size(); ++i)
-        s += (x[i] - mx) * (y[i] - my);
-    return s / (x.size() - 1);
-}
-}
-
 /**
- * Record a realised trade return for user @p u on date @p d.
+ * Record a realised trade for user @p u on date @p d.
  * The return is size‑weighted so bigger trades influence alpha more.
  */
 void AlphaCalculator::addTrade(int u, const QDate& d,
-                               double rp, double w) {
-    auto& bucket = buckets[u][d];
-    bucket.wRp += w * rp;
-    bucket.w   += w;
+                               double rp, double w, double pnl) {
+    Window &win = windows[u];
+    Tally one;
+    one.add(rp, pnl);
+    update(win, d, w * rp, w, one);
+    emit statsUpdated(u, compute(win));
 }
 
-/** Add benchmark return for a given day. When both sides of that day are
- *  known (trade + benchmark) we recompute alpha. */
-void AlphaCalculator::addBenchmark(int u, const QDate& d,
-                                   double rb, double w) {
-    auto& bucket = buckets[u][d];
-    bucket.wRb += w * rb;
-    bucket.w   += w;
+/**
+ * Final benchmark return for @p d. Stored once; every user with trades
+ * on that day gets a complete point (typically once a day, O(users)).
+ */
+void AlphaCalculator::addBenchmark(const QDate& d, double rb) {
+    benchmark.insert(d, rb);
+    const QDate first = benchmark.lastKey().addDays(1 - BUCKET_WINDOW);
+    while (!benchmark.isEmpty() && benchmark.firstKey() < first)
+        benchmark.erase(benchmark.begin());
+
+    for (auto it = windows.begin(); it != windows.end(); ++it) {
+        Window &win = it.value();
+        auto b = win.days.rbegin();
+        while (b != win.days.rend() && b->day > d) ++b;
+        if (b == win.days.rend() || b->day != d) continue;
+
+        if (b->complete()) win.sums.remove(b->rb, b->rp());
+        b->rb    = rb;
+        b->hasRb = true;
+        if (!b->complete()) continue;
+
+        win.sums.add(b->rb, b->rp());
+        emit statsUpdated(it.key(), compute(win));
+    }
+}
 
-    if (bucket.wRp != 0.0)
-        computeAlpha(u);
+PerformanceStats AlphaCalculator::stats(int u) const {
+    const auto it = windows.constFind(u);
+    return it == windows.cend() ? PerformanceStats{} : compute(*it);
 }
 
 // -----------------------------------------------------------------------
 // Internal
 // -----------------------------------------------------------------------
 
-// Sliding‑window Jensen’s alpha (ordinary least squares beta).
-void AlphaCalculator::computeAlpha(int u) {
-    auto& dq = sliding[u];
-    dq.clear();
-
-    const auto& dayMap = buckets[u];
-    for (auto it = dayMap.cbegin();
-         it != dayMap.cend() && dq.size() < BUCKET_WINDOW;
-         ++it) {
-        const Bucket& b = it.value();
-        if (b.w == 0.0) continue; // skip days without both legs
-        dq.push_front({ b.wRp / b.w, b.wRb / b.w });
+/* Bucket for @p day, created in date order; nullptr if the day is already
+   older than the window. A newer day slides the window and evicts. */
+AlphaCalculator::DayBucket *AlphaCalculator::bucket(Window &win, const QDate &day) {
+    auto &days = win.days;
+    if (days.empty() || day > days.back().day) {
+        const QDate first = day.addDays(1 - BUCKET_WINDOW);
+        while (!days.empty() && days.front().day < first) {
+            const DayBucket &old = days.front();
+            if (old.complete()) win.sums.remove(old.rb, old.rp());
+            days.pop_front();
+        }
+        days.push_back(DayBucket{ day });
+        return &days.back();
     }
+    if (day < days.back().day.addDays(1 - BUCKET_WINDOW)) return nullptr;
 
-    if (dq.size() < 3) return; // not enough points yet
+    /* late data – usually today or yesterday, so search from the back */
+    auto it = days.end();
+    while (it != days.begin() && std::prev(it)->day >= day) --it;
+    if (it != days.end() && it->day == day) return &*it;
+    return &*days.insert(it, DayBucket{ day });
+}
+
+/* O(1): swap the day's old point for its new one in the running sums */
+void AlphaCalculator::update(Window &win, const QDate &d, double wRp, double wp,
+                             const Tally &trades) {
+    DayBucket *b = bucket(win, d);
+    if (!b) return;                                  // outside the window
+
+    if (b->complete()) win.sums.remove(b->rb, b->rp());
+    b->wRp += wRp;
+    b->wp  += wp;
+    b->trades.append(trades);
+    if (!b->hasRb) {
+        const auto rb = benchmark.constFind(d);
+        if (rb != benchmark.cend()) { b->rb = *rb;  b->hasRb = true; }
+    }
+    if (b->complete()) win.sums.add(b->rb, b->rp());
+}
 
-    std::deque<double> Rp, Rb;
-    for (const auto& p : dq) { Rp.push_back(p.rp); Rb.push_back(p.rb); }
+// α / β from the running sums (ordinary least squares), ratios from the
+// day tallies joined oldest → newest.
+PerformanceStats AlphaCalculator::compute(const Window &win) {
+    PerformanceStats out;
+    const Sums &s = win.sums;
+    Tally t;
+    for (const DayBucket &b : win.days) t.append(b.trades);
 
-    double mp = mean(Rp), mb = mean(Rb);
-    double beta = covariance(Rp, Rb, mp, mb) / variance(Rb, mb);
-    double alpha = mp - beta * mb;
+    if (s.n >= 3) {
+        const double sxx = s.xx - s.x * s.x / s.n;
+        if (sxx > 1e-18) {                           // flat benchmark – β undefined
+            out.beta     = (s.xy - s.x * s.y / s.n) / sxx;
+            out.alpha    = s.y / s.n - out.beta * s.x / s.n;
+            out.hasAlpha = true;
+        }
+    }
 
-    emit alphaUpdated(u, alpha);
+    out.trades      = t.n;
+    out.maxDrawdown = t.maxDd;
+    if (t.n > 0) {
+        const double mean = t.r / t.n;
+        out.winRate = double(t.wins) / t.n;
+        if (t.down > 0.0) out.sortino = mean / std::sqrt(t.down / t.n);
+        if (t.n > 1) {
+            const double var = (t.rr - t.r * mean) / (t.n - 1);
+            if (var > 1e-18) out.sharpe = mean / std::sqrt(var);
+        }
+    }
+    return out;
 }
 
 // -----------------------------------------------------------------------
 // Rebuild buckets from DB (used on cold start)
 // -----------------------------------------------------------------------
 
-void AlphaCalculator::rebuildBucketFromDb(int u, const QDate& d,
-                                          QSqlDatabase& db) {
-    if (buckets[u].contains(d)) return;
-
-    const QString start = d.startOfDay().toString(Qt::ISODate);
-    const QString end   = d.addDays(1).startOfDay().toString(Qt::ISODate);
+void AlphaCalculator::rebuildBucketFromDb(int u, const QDate& d) {
+    const auto win = windows.constFind(u);
+    if (win != windows.cend())
+        for (const DayBucket &b : win->days)
+            if (b.day == d && b.wp > 0.0) return;    // trade leg already loaded
 
-    QSqlQuery q(db);
-    q.prepare("SELECT size, openPrice, closingPrice "
-              "FROM \"Trade_History\" "
-              "WHERE user_id = :uid AND date >= :s AND date < :e");
+    QSqlQuery &q = DatabaseManager::getInstance().prepared(
+        "SELECT size, openPrice, pnl "
+        "FROM \"Trade_History\" "
+        "WHERE user_id = :uid AND date >= :s AND date < :e "
+        "AND closingPrice <> 0 ORDER BY date");
     q.bindValue(":uid", u);
-    q.bindValue(":s",   start);
-    q.bindValue(":e",   end);
+    q.bindValue(":s",   d.startOfDay());
+    q.bindValue(":e",   d.addDays(1).startOfDay());
 
     if (!q.exec()) {
         qWarning() << "[AlphaCalc] rebuild SQL error:" << q.lastError();
         return;
     }
 
+    /* aggregate the day first – one window update, one emit */
+    Window &w = windows[u];
+    Tally  day;
+    double wRp = 0.0, wp = 0.0;
     while (q.next()) {
         double size = q.value(0).toDouble();
         double op   = q.value(1).toDouble();
-        double cl   = q.value(2).toDouble();
+        double pnl  = q.value(2).toDouble();
+
+        double wt = std::abs(size * op);   // notional weight
+        if (wt <= 0.0) continue;
+        double rp = pnl / wt;              // individual trade return (side‑aware)
+        day.add(rp, pnl);
+        wRp += wt * rp;
+        wp  += wt;
+    }
+    if (wp <= 0.0) return;
+    update(w, d, wRp, wp, day);
+    emit statsUpdated(u, compute(w));
+}
+
+// -----------------------------------------------------------------------
+// Bulk warm‑up (cold start, before the servers listen)
+// -----------------------------------------------------------------------
+
+bool AlphaCalculator::warmUp(const QDate &today) {
+    int parts = qEnvironmentVariableIntValue("ALPHA_WARMUP_THREADS");
+    if (parts <= 0) parts = qBound(1, QThread::idealThreadCount(), 8);
+    parts = qMin(parts, 64);
+    const QDate from = today.addDays(1 - BUCKET_WINDOW);
+    const QDate to   = today.addDays(1);
+
+    QElapsedTimer clock;
+    clock.start();
+
+    /* user_id span of the window → contiguous ranges, one range scan each */
+    QSqlQuery span(DatabaseManager::getInstance().connection());
+    span.prepare("SELECT MIN(user_id), MAX(user_id) "
+                 "FROM \"Trade_History\" "
+                 "WHERE date >= :s AND date < :e AND closingPrice <> 0");
+    span.bindValue(":s", from.startOfDay());
+    span.bindValue(":e", to.startOfDay());
+    if (!span.exec() || !span.next()) {
+        qWarning() << "[AlphaCalc] warm‑up span query failed:" << span.lastError()
+                   << "– falling back to per‑day rebuilds";
+        return false;
+    }
+    if (span.value(0).isNull()) {                 // no closed trades in the window
+        qDebug() << "[AlphaCalc] warm‑up: no trades since"
+                 << from.toString(Qt::ISODate);
+        return true;
+    }
+    const qint64 lo = span.value(0).toLongLong();
+    const qint64 n  = span.value(1).toLongLong() - lo + 1;
+    parts = int(qMin<qint64>(parts, n));
+
+    /* one range per task; each fills only its own hash */
+    std::vector<QHash<int, Window>> loaded(parts);
+    std::vector<char>               ok(parts, 0);
+    {
+        QThreadPool pool;                         // private: its threads (and
+        pool.setMaxThreadCount(parts);            // their pooled connections)
+        for (int i = 0; i < parts; ++i) {         // go away with it
+            const int first = int(lo + n * i / parts);
+            const int last  = int(lo + n * (i + 1) / parts - 1);
+            pool.start([i, first, last, from, to, &loaded, &ok]() {
+                ok[i] = loadPartition(first, last, from, to, loaded[i]);
+            });
+        }
+        pool.waitForDone();
+    }
+
+    for (int i = 0; i < parts; ++i)
+        if (!ok[i]) {
+            qWarning() << "[AlphaCalc] warm‑up partition" << i << "failed –"
+                       << "falling back to per‑day rebuilds";
+            return false;
+        }
+
+    /* partitions are disjoint by user – publish in one step */
+    QHash<int, Window> all;
+    for (auto &part : loaded) {
+        if (all.isEmpty()) { all.swap(part); continue; }
+        for (auto it = part.begin(); it != part.end(); ++it)
+            all.insert(it.key(), std::move(it.value()));
+    }
+    windows.swap(all);
+
+    qDebug() << "[AlphaCalc] warmed" << windows.size() << "users from"
+             << from.toString(Qt::ISODate) << "in" << clock.elapsed() << "ms over"
+             << parts << "partitions";
+    return true;
+}
+
+/* Runs on a pool thread: stream the closed trades of users
+   @p firstUser … @p lastUser in the window, in date order per user,
+   straight into day buckets and tallies. */
+bool AlphaCalculator::loadPartition(int firstUser, int lastUser,
+                                    const QDate &from, const QDate &to,
+                                    QHash<int, Window> &out) {
+    QSqlQuery &q = DatabaseManager::getInstance().prepared(
+        "SELECT user_id, date, size, openPrice, pnl "
+        "FROM \"Trade_History\" "
+        "WHERE user_id BETWEEN :lo AND :hi "
+        "AND date >= :s AND date < :e AND closingPrice <> 0 "
+        "ORDER BY user_id, date");
+    q.setForwardOnly(true);                       // stream rows, no client‑side copy
+    q.bindValue(":lo", firstUser);
+    q.bindValue(":hi", lastUser);
+    q.bindValue(":s", from.startOfDay());
+    q.bindValue(":e", to.startOfDay());
+
+    if (!q.exec()) {
+        qWarning() << "[AlphaCalc] warm‑up SQL error:" << q.lastError();
+        return false;
+    }
+
+    int     currentUser = -1;
+    Window *win         = nullptr;
+    while (q.next()) {
+        const int u = q.value(0).toInt();
+        if (u != currentUser) { win = &out[u]; currentUser = u; }
+
+        const QDate  d    = q.value(1).toDateTime().date();
+        const double size = q.value(2).toDouble();
+        const double op   = q.value(3).toDouble();
+        const double pnl  = q.value(4).toDouble();
+
+        const double w = std::abs(size * op);    // same weighting as addTrade
+        if (w <= 0.0) continue;
+        const double rp = pnl / w;
 
-        double rp = (cl - op) / op;        // individual trade return
-        double w  = std::abs(size * op);   // notional weight
-        addTrade(u, d, rp, w);
+        DayBucket *b = bucket(*win, d);
+        if (!b) continue;
+        b->wRp += w * rp;
+        b->wp  += w;
+        b->trades.add(rp, pnl);
     }
+    q.finish();
+    return true;
 }
@@ -1,25 +1,53 @@
 /* =========================================================================
    AlphaCalculator.h – Raakin Bhatti (M.Eng. capstone)
    -------------------------------------------------------------------------
-   Per‑user Jensen’s α calculator that runs entirely in memory.
+   Per‑user performance model (Jensen’s α, β, Sharpe, Sortino, max
+   drawdown, win rate) over the last BUCKET_WINDOW days, entirely in
+   memory.
 
    Key features
    • Stream‑oriented: call addTrade() when a trade closes and addBenchmark()
-     when the daily market return arrives. Once both numbers for a date are
-     present, the class emits alphaUpdated(userID, alpha).
-   • Multi‑tenant: maintains isolated windows for every user ID.
+     once per day when the market return is final. Every change emits
+     statsUpdated(userID, stats) – O(1) per user, so it is cheap enough to
+     run on every close.
+   • Multi‑tenant: isolated windows and trade tallies for every user ID;
+     the benchmark series is stored once and shared by all of them.
    • Hot cache: avoids DB round‑trips during trading; supports
      rebuildBucketFromDb() to reload state after a restart.
+   • Bulk cold start: warmUp() loads the whole window for every user from
+     Trade_History before the servers accept connections – the window's
+     user_id span is split into N contiguous ranges, each one streamed
+     range scan aggregated in parallel on a private thread pool,
+     published in one swap.
 
    Design notes
-   • Maintains Σ(weight·Rp) / Σ(weight) and Σ(weight·Rb) / Σ(weight) per day
-     so updates are O(1).
-   • sliding[user] keeps the last BUCKET_WINDOW pairs in a deque, allowing
-     constant‑time expiry of stale data without scanning full maps.
-   • α is computed as  mean(Rp) − β·mean(Rb), where β comes from ordinary
-     least‑squares on the same window.
-   • TODO: snapshot the aggregated window to disk to cut warm‑up time on
-     server reboot.
+   • One DayBucket per calendar day keeps Σ(weight·Rp) and Σweight of the
+     trade leg; the benchmark return for that day (x = Rb) is copied in
+     from the shared series when both are known, so the exact point can be
+     subtracted again later even after the series has moved on.
+   • Only the last BUCKET_WINDOW calendar days are kept; a newer day evicts
+     the ones that fell out of the window, so memory per user is bounded.
+   • Running sums n, Σx, Σy, Σxy, Σx² cover the complete days in the
+     window. A bucket update subtracts its old point and adds the new one;
+     an eviction subtracts – no pass over the window ever.
+   • α = ȳ − β·x̄ with the OLS slope β = (Σxy − Σx·Σy/n) / (Σx² − (Σx)²/n);
+     fewer than three points or a flat benchmark leaves hasAlpha false.
+   • Sharpe, Sortino, win rate and max drawdown come from a per‑trade
+     Tally (Σr, Σr², Σmin(r,0)², wins, realised PnL path) kept in each
+     day's bucket, so they cover the same window as α / β and an evicted
+     day takes its trades with it. Every figure is therefore a rolling
+     30‑day one and identical whether the window was streamed or
+     rebuilt by warmUp() after a restart. Ratios are per trade, not
+     annualised; drawdown is the largest peak‑to‑trough fall of realised
+     PnL inside the window.
+   • The day tallies are folded oldest → newest in compute(): drawdown
+     does not subtract, so this is the one O(window) step (≤ 30 buckets
+     per close).
+   • warmUp() workers only touch their own partition's windows and their
+     own pooled connection; nothing is visible (and nothing is emitted)
+     until every partition has loaded, so a failed warm‑up leaves the
+     calculator empty and rebuildBucketFromDb() as the fallback.
+   • Not thread‑safe – owned by AnalyticsEngine and used on its thread.
    ========================================================================= */
 
 #ifndef ALPHACALCULATOR_H
@@ -27,17 +55,25 @@
 
 #include <QObject>
 #include <QDate>
+#include <QHash>
 #include <QMap>
 #include <deque>
 #include <QtSql/QSqlDatabase>
 
 constexpr int BUCKET_WINDOW = 30;   // length of the sliding window (days)
 
-struct Bucket {
-    double wRp = 0.0;   // Σ(weight · portfolio return)
-    double wRb = 0.0;   // Σ(weight · benchmark return)
-    double w   = 0.0;   // Σ(weight) – denominator for weighted means
+/* All figures cover the last BUCKET_WINDOW days */
+struct PerformanceStats {
+    double alpha       = 0.0;
+    double beta        = 0.0;
+    double sharpe      = 0.0;
+    double sortino     = 0.0;
+    double maxDrawdown = 0.0;   // realised PnL, account currency
+    double winRate     = 0.0;   // 0 … 1
+    int    trades      = 0;
+    bool   hasAlpha    = false; // enough complete days for α / β
 };
+Q_DECLARE_METATYPE(PerformanceStats)
 
 class AlphaCalculator : public QObject
 {
@@ -45,32 +81,108 @@ class AlphaCalculator : public QObject
 public:
     explicit AlphaCalculator(QObject *parent = nullptr);
 
-    // Adds a realised trade return for a given day
+    // Adds a realised trade: size‑weighted return, its weight and its PnL
     void addTrade(int    userID,
                   const  QDate &day,
                   double retPortfolio,
-                  double weight);
+                  double weight,
+                  double pnl);
 
-    // Adds benchmark return for a given day (e.g., S&P 500 daily)
-    void addBenchmark(int    userID,
-                      const  QDate &day,
-                      double retBenchmark,
-                      double weight);
+    // Final benchmark return for a day – shared by every user
+    void addBenchmark(const QDate &day,
+                      double retBenchmark);
 
-    // Rebuilds the in‑memory buckets from historical records, used at start‑up
+    // Rebuilds the in‑memory buckets from historical records, used at start‑up.
+    // Safe on any thread: runs on that thread's pooled connection.
     void rebuildBucketFromDb(int userID,
-                             const QDate &fromDay,
-                             QSqlDatabase &db);
+                             const QDate &fromDay);
+
+    // Loads the BUCKET_WINDOW days up to @p today for all users at once
+    // ($ALPHA_WARMUP_THREADS partitions). Call before the first addTrade().
+    bool warmUp(const QDate &today);
+
+    PerformanceStats stats(int userID) const;
+    int              users() const { return windows.size(); }
 
 signals:
-    void alphaUpdated(int userID, double alpha);
+    void statsUpdated(int userID, const PerformanceStats &stats);
 
 private:
-    void computeAlpha(int userID);
+    /* Per‑trade figures of a run of trades, in close order. The PnL path
+       is kept as (sum, highest / lowest prefix, worst fall) so two runs
+       can be joined without replaying them. */
+    struct Tally {
+        int    n     = 0;
+        int    wins  = 0;
+        double r     = 0.0;   // Σ return
+        double rr    = 0.0;   // Σ return²
+        double down  = 0.0;   // Σ min(return, 0)²
+        double pnl   = 0.0;   // Σ realised PnL
+        double high  = 0.0;   // max prefix of PnL (≥ 0, the empty prefix)
+        double low   = 0.0;   // min prefix of PnL (≤ 0)
+        double maxDd = 0.0;   // largest peak‑to‑trough fall inside the run
+
+        void add(double ret, double p) {
+            Tally one;
+            one.n = 1;  one.r = ret;  one.rr = ret * ret;
+            if (ret < 0.0) one.down = ret * ret;
+            if (p > 0.0) one.wins = 1;
+            one.pnl   = p;
+            one.high  = qMax(0.0, p);
+            one.low   = qMin(0.0, p);
+            one.maxDd = qMax(0.0, -p);
+            append(one);
+        }
+        /* this run followed by @p next */
+        void append(const Tally &next) {
+            maxDd = qMax(qMax(maxDd, next.maxDd), high - (pnl + next.low));
+            high  = qMax(high, pnl + next.high);
+            low   = qMin(low,  pnl + next.low);
+            n += next.n;  wins += next.wins;
+            r += next.r;  rr += next.rr;  down += next.down;
+            pnl += next.pnl;
+        }
+    };
+
+    struct DayBucket {
+        QDate  day;
+        double wRp   = 0.0;   // Σ(weight · portfolio return)
+        double wp    = 0.0;   // Σ(weight) of the trade leg
+        double rb    = 0.0;   // benchmark return, once known
+        bool   hasRb = false;
+        Tally  trades;        // the day's closes, for the per‑trade ratios
+
+        bool   complete() const { return wp > 0.0 && hasRb; }
+        double rp()       const { return wRp / wp; }
+    };
+
+    /* Σ over the complete days in the window; x = Rb, y = Rp */
+    struct Sums {
+        int    n  = 0;
+        double x  = 0.0;
+        double y  = 0.0;
+        double xy = 0.0;
+        double xx = 0.0;
+
+        void add   (double rb, double rp) { ++n; x += rb; y += rp; xy += rb * rp; xx += rb * rb; }
+        void remove(double rb, double rp) { --n; x -= rb; y -= rp; xy -= rb * rp; xx -= rb * rb; }
+    };
+
+    struct Window {
+        std::deque<DayBucket> days;   // ascending, within BUCKET_WINDOW of the newest
+        Sums                  sums;
+    };
+
+    static DayBucket       *bucket(Window &w, const QDate &day);
+    static PerformanceStats compute(const Window &w);
+    static bool             loadPartition(int firstUser, int lastUser,
+                                          const QDate &from, const QDate &to,
+                                          QHash<int, Window> &out);
+    void                    update(Window &w, const QDate &day,
+                                   double wRp, double wp, const Tally &trades);
 
-    QMap<int, QMap<QDate, Bucket>> buckets;   // per‑user day→bucket map
-    struct Pair { double rp; double rb; };
-    QMap<int, std::deque<Pair>> sliding;      // per‑user 30‑day sliding window
+    QHash<int, Window>  windows;              // per‑user 30‑day window
+    QMap<QDate, double> benchmark;            // shared daily Rb, last BUCKET_WINDOW days
 };
 
 #endif // ALPHACALCULATOR_H
@@ -0,0 +1,139 @@
+/* =========================================================================
+   AnalyticsEngine.cpp – implementation of AnalyticsEngine.h
+   -------------------------------------------------------------------------
+   Closed trade / benchmark in → AlphaCalculator → alpha out + batched
+   "Account_Analytics" upserts.
+   ========================================================================= */
+
+#include "analyticsengine.h"
+#include "DatabaseManager.h"
+
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QtDebug>
+
+#include <cmath>
+
+AnalyticsEngine::AnalyticsEngine(QObject *parent)
+    : QObject(parent),
+    model(this)
+{
+    qRegisterMetaType<PerformanceStats>();
+    connect(&model, &AlphaCalculator::statsUpdated,
+            this,   &AnalyticsEngine::onStats);
+}
+
+bool AnalyticsEngine::warmUp(const QDate &today){
+    return model.warmUp(today);
+}
+
+/* ------------------------------ analytics thread ------------------------ */
+void AnalyticsEngine::start(){
+    QSqlQuery q(DatabaseManager::getInstance().connection());
+    if (!q.exec("CREATE TABLE IF NOT EXISTS \"Account_Analytics\" ("
+                "user_id integer PRIMARY KEY, alpha_30d float8, beta_30d float8, "
+                "sharpe_30d float8, sortino_30d float8, max_drawdown_30d float8, "
+                "win_rate_30d float8, trades_30d integer, "
+                "updated_at timestamptz NOT NULL DEFAULT now())"))
+        qWarning() << "[AnalyticsEngine] cannot create Account_Analytics:"
+                   << q.lastError();
+
+    timer = new QTimer(this);
+    connect(timer, &QTimer::timeout, this, &AnalyticsEngine::flush);
+    timer->start(FLUSH_MS);
+    qDebug() << "[AnalyticsEngine]" << model.users() << "users warm, using"
+             << DatabaseManager::getInstance().connection().connectionName();
+}
+
+void AnalyticsEngine::stop(){
+    if (timer) timer->stop();
+    flush();
+    if (!dirty.isEmpty())
+        qWarning() << "[AnalyticsEngine]" << dirty.size()
+                   << "rows not written on shutdown";
+}
+
+void AnalyticsEngine::addTrade(const TradeEvent &e){
+    const double w = std::abs(e.size * e.openPrice);   // notional weight
+    if (w <= 0.0) return;
+    model.addTrade(e.userID, e.at.date(), e.pnl / w, w, e.pnl);
+}
+
+void AnalyticsEngine::addBenchmark(const QDate &day, double ret){
+    model.addBenchmark(day, ret);
+}
+
+void AnalyticsEngine::onStats(int uid, const PerformanceStats &s){
+    dirty.insert(uid, s);                          // newest wins until flush
+    if (s.hasAlpha) emit alphaUpdated(uid, s.alpha);
+}
+
+/* ------------------------------------------------------------------------
+   Dirty users → one transaction of INSERT … ON CONFLICT chunks.
+   ------------------------------------------------------------------------ */
+static QString upsertSql(int rows){
+    QStringList values;
+    for (int i = 0; i < rows; ++i) values << QStringLiteral("(?,?,?,?,?,?,?,?,now())");
+    return "INSERT INTO \"Account_Analytics\" "
+           "(user_id,alpha_30d,beta_30d,sharpe_30d,sortino_30d,"
+           "max_drawdown_30d,win_rate_30d,trades_30d,updated_at) "
+           "VALUES " + values.join(',') + " "
+           "ON CONFLICT (user_id) DO UPDATE SET "
+           "alpha_30d = EXCLUDED.alpha_30d, beta_30d = EXCLUDED.beta_30d, "
+           "sharpe_30d = EXCLUDED.sharpe_30d, sortino_30d = EXCLUDED.sortino_30d, "
+           "max_drawdown_30d = EXCLUDED.max_drawdown_30d, "
+           "win_rate_30d = EXCLUDED.win_rate_30d, "
+           "trades_30d = EXCLUDED.trades_30d, updated_at = EXCLUDED.updated_at";
+}
+
+void AnalyticsEngine::flush(){
+    if (dirty.isEmpty()) return;
+
+    QSqlDatabase &db = DatabaseManager::getInstance().connection();
+    const QList<int> ids = dirty.keys();
+    static const QString fullChunk = upsertSql(FLUSH_ROWS);
+
+    if (!db.transaction()) {
+        qWarning() << "[AnalyticsEngine] BEGIN failed:" << db.lastError().text();
+        return;                                    // stay dirty, retry later
+    }
+
+    for (int from = 0; from < ids.size(); from += FLUSH_ROWS) {
+        const int n = qMin(FLUSH_ROWS, int(ids.size()) - from);
+
+        /* full chunks share one text → prepared‑statement cache hit; the
+           tail's size differs every flush, so it is prepared uncached
+           instead of evicting the cache's hot statements */
+        QSqlQuery  tail(db);
+        QSqlQuery *q = &tail;
+        if (n == FLUSH_ROWS)
+            q = &DatabaseManager::getInstance().prepared(fullChunk);
+        else
+            tail.prepare(upsertSql(n));
+
+        for (int i = from; i < from + n; ++i) {
+            const PerformanceStats &s = dirty[ids[i]];
+            q->addBindValue(ids[i]);
+            q->addBindValue(s.hasAlpha ? QVariant(s.alpha) : QVariant());
+            q->addBindValue(s.hasAlpha ? QVariant(s.beta)  : QVariant());
+            q->addBindValue(s.sharpe);
+            q->addBindValue(s.sortino);
+            q->addBindValue(s.maxDrawdown);
+            q->addBindValue(s.winRate);
+            q->addBindValue(s.trades);
+        }
+        if (!q->exec()) {
+            qWarning() << "[AnalyticsEngine] flush failed:" << q->lastError();
+            db.rollback();
+            return;
+        }
+    }
+
+    if (!db.commit()) {
+        qWarning() << "[AnalyticsEngine] COMMIT failed:" << db.lastError().text();
+        db.rollback();
+        return;
+    }
+    dirty.clear();
+}
@@ -0,0 +1,78 @@
+/* =========================================================================
+   AnalyticsEngine.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   The cloud's one performance‑analytics service: α, β, Sharpe, Sortino,
+   max drawdown and win rate over the last 30 days for every user, off
+   the engine thread.
+
+   Key features
+   • Single instance, owned by TradeServer and run on its own "analytics"
+     QThread – trade closes and the daily benchmark return are posted to
+     it, so no shard or socket ever waits on statistics.
+   • Wraps one AlphaCalculator: every closed trade is fed exactly once
+     and the benchmark series is stored once for all users.
+   • Fresh alpha values go back through alphaUpdated(userID, alpha), to
+     AccountServer's ledger (the "Account".alpha column) and the user's
+     dashboards.
+   • Every figure is also persisted to "Account_Analytics" in coalesced
+     batches: a user updated many times between flushes is written once,
+     FLUSH_ROWS rows per INSERT … ON CONFLICT statement, every FLUSH_MS.
+     The columns carry a _30d suffix – they are rolling‑window figures,
+     rebuilt identically by warm‑up after a restart, never lifetime
+     totals.
+
+   Design notes
+   • warmUp() runs before the thread starts (from TradeServer's ctor, so
+     before listen()); after that the object is only touched through
+     queued calls.
+   • Returns are side‑aware: pnl / |size · openPrice|, weighted by the
+     same notional.
+   • The table is created on start() if it does not exist yet. A failed
+     flush keeps its rows dirty and the next tick retries with the latest
+     values – nothing is double‑applied.
+   • stop() (blocking, from the owner) flushes one last time.
+   ========================================================================= */
+
+#ifndef ANALYTICSENGINE_H
+#define ANALYTICSENGINE_H
+
+#include "alphacalculator.h"
+#include "tradeevent.h"
+
+#include <QObject>
+#include <QHash>
+#include <QTimer>
+
+class AnalyticsEngine : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int FLUSH_MS   = 1000;
+    static constexpr int FLUSH_ROWS = 500;     // rows per INSERT statement
+
+    explicit AnalyticsEngine(QObject *parent = nullptr);
+
+    /* Owner thread, before the analytics thread starts. */
+    bool warmUp(const QDate &today);
+
+public slots:
+    /* Analytics thread. */
+    void start();
+    void stop();
+    void flush();
+
+    void addTrade    (const TradeEvent &closed);
+    void addBenchmark(const QDate &day, double ret);
+
+signals:
+    void alphaUpdated(int userID, double alpha);
+
+private:
+    void onStats(int userID, const PerformanceStats &stats);
+
+    AlphaCalculator                 model;
+    QHash<int, PerformanceStats>    dirty;     // latest figures not yet written
+    QTimer                         *timer {nullptr};
+};
+
+#endif // ANALYTICSENGINE_H
@@ -1,7 +1,10 @@
 #ifndef ASSET_H
 #define ASSET_H
 
-enum Asset {
+/* Fixed underlying type: the four named symbols keep their wire values,
+   and any extra symbol loaded into InstrumentTable gets the next integer
+   id (4, 5, …) without needing an enumerator of its own. */
+enum Asset : int {
     BTCUSDT, // Bitcoin to USDT
     ETHUSDT, // Ethereum to USDT
     SOLUSDT, // Solana to USDT
@@ -0,0 +1,90 @@
+/* =========================================================================
+   bench/account_bench.cpp – AccountServer event and alpha cost
+   -------------------------------------------------------------------------
+     • account_event – one equity push through the code behind
+                       AccountServer::broadcast: AccountEvent::equity
+                       (JSON object + Wire event) and AccountEvent::fanOut
+                       (session look‑up, compact JSON serialised once per
+                       event). Sockets are stand‑ins that only count bytes
+                       – the socket write is kernel time, not engine time.
+     • alpha_compute – AlphaCalculator::addTrade on a day whose benchmark
+                       return is already known, i.e. one running‑sum
+                       update plus the full stats over a BUCKET_WINDOW,
+                       cycling through U users.
+   ========================================================================= */
+
+#include "benchharness.h"
+
+#include "accountevent.h"
+#include "alphacalculator.h"
+
+#include <random>
+
+namespace {
+
+/* Stands in for QWebSocket in AccountEvent::fanOut. */
+struct CountingSocket {
+    qint64 sendTextMessage(const QString &msg){
+        Bench::consume(msg.size());
+        return msg.size();
+    }
+    qint64 sendBinaryMessage(const QByteArray &frame){
+        Bench::consume(frame.size());
+        return frame.size();
+    }
+};
+
+void accountEvent(Bench::Harness &h, int users, bool binary){
+    /* one socket per user, all in the same format */
+    QList<CountingSocket>             sockets(users);
+    QMap<int, QList<CountingSocket*>> sessions;
+    QSet<CountingSocket*>             binarySockets;
+    for (int u = 1; u <= users; ++u) {
+        CountingSocket *s = &sockets[u - 1];
+        sessions.insert(u, { s });
+        if (binary) binarySockets.insert(s);
+    }
+
+    const QJsonObject params {{ "users", users }, { "format", binary ? "binary" : "json" }};
+    h.run("account_event", params, 0, [&](quint64 n) {
+        for (quint64 i = 0; i < n; ++i) {
+            const int    uid    = int(i % quint64(users)) + 1;
+            const double equity = 1000.0 + double(i & 0xFF);
+            AccountEvent::equity(equity).fanOut(sessions, binarySockets, uid);
+        }
+    });
+}
+
+void alphaCompute(Bench::Harness &h, int users){
+    AlphaCalculator alpha;
+    std::mt19937 rng(99);
+    std::normal_distribution<double> ret(0.0, 0.02);
+    const QDate today(2025, 1, 31);
+
+    for (int d = BUCKET_WINDOW - 1; d >= 0; --d)
+        alpha.addBenchmark(today.addDays(-d), ret(rng));
+    for (int u = 1; u <= users; ++u)
+        for (int d = BUCKET_WINDOW - 1; d >= 0; --d) {
+            const double r = ret(rng);
+            alpha.addTrade(u, today.addDays(-d), r, 1.0, r);
+        }
+
+    h.run("alpha_compute", {{ "users", users }}, 0, [&](quint64 n) {
+        for (quint64 i = 0; i < n; ++i)
+            alpha.addTrade(int(i % quint64(users)) + 1, today, 1e-4, 1.0, 1e-4);
+    });
+}
+
+} // namespace
+
+void Bench::accountCases(Harness &h){
+    const QList<int> us = userCounts(h.options());
+
+    if (h.enabled("account_event"))
+        for (int u : us) {
+            accountEvent(h, u, false);
+            accountEvent(h, u, true);
+        }
+    if (h.enabled("alpha_compute"))
+        for (int u : us) alphaCompute(h, u);
+}
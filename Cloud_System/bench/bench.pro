@@ -0,0 +1,43 @@
+QT = core
+QT += sql
+
+CONFIG += c++17 cmdline
+CONFIG -= app_bundle
+
+TARGET = cloud_bench
+
+# Benchmarks are meaningless without optimisation.
+CONFIG += release
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+INCLUDEPATH += ..
+
+# The cases drive the real engine code, compiled from the parent project.
+SOURCES += \
+        main.cpp \
+        account_bench.cpp \
+        engine_bench.cpp \
+        kline_bench.cpp \
+        ../alphacalculator.cpp \
+        ../engineshard.cpp \
+        ../exposurebook.cpp \
+        ../positionstore.cpp \
+        ../riskgate.cpp \
+        ../trade.cpp \
+        ../tradejournal.cpp \
+        ../triggerbook.cpp
+
+HEADERS += \
+    benchharness.h \
+    ../accountevent.h \
+    ../alphacalculator.h \
+    ../engineshard.h \
+    ../exposurebook.h \
+    ../klinedecoder.h \
+    ../objectpool.h \
+    ../positionstore.h \
+    ../riskgate.h \
+    ../trade.h \
+    ../tradejournal.h \
+    ../triggerbook.h \
+    ../wireprotocol.h
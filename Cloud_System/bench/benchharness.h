@@ -0,0 +1,156 @@
+/* =========================================================================
+   bench/BenchHarness.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Tiny self‑calibrating benchmark runner shared by the cloud_bench cases.
+
+   Key features
+   • run(name, params, fn) calls fn(n) with a growing n until one batch
+     takes at least --min-ms, then reports that batch: ns/op and heap
+     allocations/op (global operator new is counted in bench/main.cpp).
+   • An optional "items" count per op (positions, users …) adds ns/item,
+     so a per‑tick cost can be read as a per‑position cost too.
+   • Results print as an aligned table and can be written as JSON
+     (--json FILE) with host / Qt / build details, so two commits can be
+     diffed mechanically.
+   • --filter SUBSTR runs only matching cases; --quick shrinks both the
+     populations (positionCounts() / userCounts()) and the measuring time.
+
+   Design notes
+   • Setup (building populations) happens outside run(); only the work
+     inside fn is timed and counted.
+   • A volatile sink (Bench::consume) keeps results alive so the compiler
+     cannot drop the measured work.
+   ========================================================================= */
+
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QStringList>
+#include <QString>
+#include <QTextStream>
+
+#include <atomic>
+
+namespace Bench {
+
+/* Defined in bench/main.cpp next to the counting operator new. */
+quint64 allocations();
+
+inline volatile double g_sink = 0.0;
+inline void consume(double v) { g_sink = g_sink + v; }
+
+struct Options {
+    QString filter;
+    QString jsonPath;
+    qint64  minNs = 200'000'000;     // --min-ms, default 200
+    bool    quick = false;
+};
+
+struct Result {
+    QString     name;
+    QJsonObject params;
+    quint64     ops         = 0;
+    double      nsPerOp     = 0.0;
+    double      allocsPerOp = 0.0;
+    double      items       = 0.0;   // per op; 0 = not applicable
+};
+
+class Harness
+{
+public:
+    explicit Harness(const Options &o) : opts(o), out(stdout) {}
+
+    const Options &options() const { return opts; }
+    bool enabled(const QString &name) const {
+        return opts.filter.isEmpty() || name.contains(opts.filter);
+    }
+
+    /* fn(quint64 n) must perform exactly n operations. */
+    template <typename Fn>
+    void run(const QString &name, const QJsonObject &params, double items, Fn fn){
+        if (!enabled(name)) return;
+        fn(1);                                              // warm caches / lazies
+
+        quint64 n = 1;
+        qint64  ns = 0;
+        quint64 allocs = 0;
+        for (;;) {
+            const quint64 a0 = allocations();
+            QElapsedTimer t;  t.start();
+            fn(n);
+            ns     = t.nsecsElapsed();
+            allocs = allocations() - a0;
+            if (ns >= opts.minNs || n >= (quint64(1) << 40)) break;
+            const double grow = ns > 0 ? 1.3 * double(opts.minNs) / double(ns) : 100.0;
+            n = quint64(double(n) * qBound(2.0, grow, 100.0));
+        }
+
+        Result r;
+        r.name        = name;
+        r.params      = params;
+        r.ops         = n;
+        r.nsPerOp     = double(ns) / double(n);
+        r.allocsPerOp = double(allocs) / double(n);
+        r.items       = items;
+        results << r;
+        print(r);
+    }
+
+    const QList<Result> &all() const { return results; }
+
+    QJsonArray toJson() const {
+        QJsonArray arr;
+        for (const Result &r : results) {
+            QJsonObject o;
+            o["name"]        = r.name;
+            o["params"]      = r.params;
+            o["ops"]         = qint64(r.ops);
+            o["nsPerOp"]     = r.nsPerOp;
+            o["allocsPerOp"] = r.allocsPerOp;
+            if (r.items > 0) o["nsPerItem"] = r.nsPerOp / r.items;
+            arr << o;
+        }
+        return arr;
+    }
+
+private:
+    void print(const Result &r){
+        QStringList p;
+        for (auto it = r.params.constBegin(); it != r.params.constEnd(); ++it)
+            p << it.key() + "=" + it.value().toVariant().toString();
+        out << QString("%1 %2 %3 ns/op %4 allocs/op")
+                   .arg(r.name, -16)
+                   .arg(p.join(' '), -36)
+                   .arg(r.nsPerOp, 12, 'f', 1)
+                   .arg(r.allocsPerOp, 9, 'f', 2);
+        if (r.items > 0)
+            out << QString(" %1 ns/item").arg(r.nsPerOp / r.items, 9, 'f', 2);
+        out << '\n';
+        out.flush();
+    }
+
+    Options       opts;
+    QTextStream   out;
+    QList<Result> results;
+};
+
+/* Population sizes used by the cases – trimmed under --quick. */
+inline QList<int> positionCounts(const Options &o){
+    return o.quick ? QList<int>{ 1, 1000, 10000 } : QList<int>{ 1, 1000, 10000, 100000 };
+}
+inline QList<int> userCounts(const Options &o){
+    return o.quick ? QList<int>{ 1, 100, 1000 } : QList<int>{ 1, 100, 1000, 10000 };
+}
+
+/* Cases, one translation unit each */
+void klineCases  (Harness &h);
+void engineCases (Harness &h);
+void accountCases(Harness &h);
+
+} // namespace Bench
+
+#endif // BENCHHARNESS_H
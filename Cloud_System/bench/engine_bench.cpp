@@ -0,0 +1,141 @@
+/* =========================================================================
+   bench/engine_bench.cpp – per‑tick engine cost over synthetic books
+   -------------------------------------------------------------------------
+     • mark_to_market  – PositionStore::markToMarket, P positions in one
+                         asset (the old TradeServer::updateAssetPnL loop).
+     • trigger_collect – TriggerBook::collect at a price that crosses no
+                         level (the old checkLimits scan).
+     • exposure_pnl    – ExposureBook::unrealisedPnL for one user holding
+                         all four assets (equity per dirty user).
+     • shard_tick      – EngineShard::onPriceTicks end to end: marks,
+                         triggers, dirty fan‑out, equity and "positions"
+                         frames. dashboards=none/json/binary isolates the
+                         tradeDashboardUpdate serialisation cost.
+   Prices wiggle by ±0.05 % around 100; SL / TP sit at ±50 %, so nothing
+   closes and the population stays fixed while measuring.
+   ========================================================================= */
+
+#include "benchharness.h"
+
+#include "engineshard.h"
+#include "exposurebook.h"
+#include "positionstore.h"
+#include "triggerbook.h"
+
+#include <QTemporaryDir>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int    ASSETS = 4;
+constexpr double PRICE  = 100.0;
+
+inline double wiggle(quint64 i) { return PRICE * (1.0 + ((i & 1) ? 5e-4 : -5e-4)); }
+
+/* P positions spread over U users and the four built‑in assets */
+QList<JournalPosition> population(int positions, int users, int assets){
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<double> size(0.01, 1.0);
+    QList<JournalPosition> out;
+    out.reserve(positions);
+    for (int i = 0; i < positions; ++i) {
+        JournalPosition p;
+        p.tradeID   = TradeId(i + 1);
+        p.userID    = i % users + 1;
+        p.asset     = static_cast<Asset>(i % assets);
+        p.side      = (rng() & 1) ? TradeSide::Long : TradeSide::Short;
+        p.size      = size(rng);
+        p.openPrice = PRICE;
+        const bool isLong = p.side == TradeSide::Long;
+        p.stopLoss   = isLong ? PRICE * 0.5 : PRICE * 1.5;
+        p.takeProfit = isLong ? PRICE * 1.5 : PRICE * 0.5;
+        out << p;
+    }
+    return out;
+}
+
+std::vector<std::unique_ptr<Trade>> trades(const QList<JournalPosition> &ps){
+    std::vector<std::unique_ptr<Trade>> out;
+    out.reserve(ps.size());
+    for (const JournalPosition &p : ps)
+        out.emplace_back(new Trade(p.tradeID, p.stopLoss, p.takeProfit, p.size,
+                                   p.asset, p.openPrice, p.type, p.side));
+    return out;
+}
+
+void markToMarket(Bench::Harness &h, int positions){
+    const auto owned = trades(population(positions, 1, 1));
+    PositionStore store;
+    for (const auto &t : owned) store.add(t.get(), PRICE);
+
+    h.run("mark_to_market", {{ "positions", positions }}, positions, [&](quint64 n) {
+        for (quint64 i = 0; i < n; ++i) store.markToMarket(wiggle(i));
+        Bench::consume(store.pnl(owned.front().get()));
+    });
+}
+
+void triggerCollect(Bench::Harness &h, int positions){
+    const QList<JournalPosition> ps = population(positions, 1, 1);
+    const auto owned = trades(ps);
+    TriggerBook book;
+    for (const auto &t : owned) book.add(1, t.get());
+
+    h.run("trigger_collect", {{ "positions", positions }}, 0, [&](quint64 n) {
+        for (quint64 i = 0; i < n; ++i) Bench::consume(book.collect(wiggle(i)).size());
+    });
+}
+
+void exposurePnl(Bench::Harness &h, int users){
+    ExposureBook book;
+    QMap<Asset, double> prices;
+    for (int a = 0; a < ASSETS; ++a) prices.insert(static_cast<Asset>(a), PRICE);
+    for (int u = 1; u <= users; ++u)
+        for (int a = 0; a < ASSETS; ++a)
+            book.add(u, static_cast<Asset>(a), (a & 1) ? -0.5 : 0.5, PRICE * 0.99);
+
+    h.run("exposure_pnl", {{ "users", users }}, 0, [&](quint64 n) {
+        for (quint64 i = 0; i < n; ++i)
+            Bench::consume(book.unrealisedPnL(int(i % quint64(users)) + 1, prices));
+    });
+}
+
+void shardTick(Bench::Harness &h, int positions, int users){
+    QTemporaryDir dir;
+    EngineShard shard(0, dir.path());
+    shard.restore(population(positions, users, ASSETS));
+
+    const struct { const char *name; SessionFormats f; } variants[] = {
+        { "none",   { false, false } },
+        { "json",   { true,  false } },
+        { "binary", { false, true  } },
+    };
+    for (const auto &v : variants) {
+        for (int u = 1; u <= users; ++u) shard.setSessionFormats(u, v.f);
+        const QJsonObject params {{ "positions", positions }, { "users", users },
+                                  { "dashboards", v.name }};
+        /* one tick of one asset per op – items = positions in that asset */
+        h.run("shard_tick", params, double(positions) / ASSETS, [&](quint64 n) {
+            for (quint64 i = 0; i < n; ++i) {
+                const Asset a = static_cast<Asset>(i % ASSETS);
+                shard.onPriceTicks({ EngineShard::PriceTick(a, wiggle(i / ASSETS)) });
+            }
+        });
+    }
+}
+
+} // namespace
+
+void Bench::engineCases(Harness &h){
+    const QList<int> ps = positionCounts(h.options());
+    const QList<int> us = userCounts(h.options());
+
+    if (h.enabled("mark_to_market"))  for (int p : ps) markToMarket(h, p);
+    if (h.enabled("trigger_collect")) for (int p : ps) triggerCollect(h, p);
+    if (h.enabled("exposure_pnl"))    for (int u : us) exposurePnl(h, u);
+    if (h.enabled("shard_tick"))
+        for (int i = 0; i < ps.size() && i < us.size(); ++i)
+            shardTick(h, ps[i], us[i]);
+}
@@ -0,0 +1,48 @@
+/* =========================================================================
+   bench/kline_bench.cpp – Binance k‑line frame → close price
+   -------------------------------------------------------------------------
+     • kline_qjson   – the old extractClose() path: toUtf8() + QJsonDocument
+                       + two QJsonObject look‑ups + QString::toDouble().
+     • kline_decoder – KlineDecoder::decode() straight off the QString.
+   ========================================================================= */
+
+#include "benchharness.h"
+#include "klinedecoder.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace {
+
+const QString FRAME = QStringLiteral(
+    "{\"stream\":\"btcusdt@kline_1m\",\"data\":{\"e\":\"kline\",\"E\":1716220000123,"
+    "\"s\":\"BTCUSDT\",\"k\":{\"t\":1716219960000,\"T\":1716220019999,\"s\":\"BTCUSDT\","
+    "\"i\":\"1m\",\"f\":3598000001,\"L\":3598000420,\"o\":\"67012.34000000\","
+    "\"c\":\"67020.01000000\",\"h\":\"67031.50000000\",\"l\":\"67001.12000000\","
+    "\"v\":\"12.34567000\",\"n\":420,\"x\":false,\"q\":\"827365.12345678\","
+    "\"V\":\"6.54321000\",\"Q\":\"438512.87654321\",\"B\":\"0\"}}}");
+
+/* Old TradeServer path, kept verbatim for comparison. */
+inline double extractCloseQJson(const QString &msg){
+    QJsonDocument d = QJsonDocument::fromJson(msg.toUtf8());
+    return d.object()["data"].toObject()["k"].toObject()["c"].toString().toDouble();
+}
+
+inline double extractCloseDecoder(const QString &msg){
+    KlineFrame k;
+    return KlineDecoder::decode(msg, k) ? k.close : 0.0;
+}
+
+} // namespace
+
+void Bench::klineCases(Harness &h){
+    if (extractCloseQJson(FRAME) != extractCloseDecoder(FRAME))
+        qFatal("[bench] kline decoder mismatch");
+
+    h.run("kline_qjson", {}, 0, [](quint64 n) {
+        for (quint64 i = 0; i < n; ++i) consume(extractCloseQJson(FRAME));
+    });
+    h.run("kline_decoder", {}, 0, [](quint64 n) {
+        for (quint64 i = 0; i < n; ++i) consume(extractCloseDecoder(FRAME));
+    });
+}
@@ -0,0 +1,99 @@
+/* =========================================================================
+   bench/main.cpp – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Hot‑path micro‑benchmarks for the cloud engine.
+
+     • kline_*        frame → close price (kline_bench.cpp)
+     • mark_to_market, trigger_collect, exposure_pnl, shard_tick
+                      per‑tick engine work over 1 – 100 k positions and
+                      1 – 10 k users (engine_bench.cpp)
+     • account_event, alpha_compute
+                      AccountServer push encoding and Jensen's α
+                      (account_bench.cpp)
+
+   Reports ns/op and heap allocations/op (global operator new is counted
+   for the whole binary), plus ns/item where an op covers a population.
+
+   Usage:  cloud_bench [--filter SUBSTR] [--quick] [--min-ms N] [--json FILE]
+   ========================================================================= */
+
+#include "benchharness.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QSysInfo>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/* ---------------------------- allocation probe ------------------------ */
+static std::atomic<quint64> g_allocs {0};
+
+void *operator new(std::size_t n){
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept              { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+quint64 Bench::allocations(){ return g_allocs.load(std::memory_order_relaxed); }
+
+static bool writeJson(const QString &path, const Bench::Harness &h){
+    QJsonObject build;
+    build["qt"]      = qVersion();
+    build["cpu"]     = QSysInfo::currentCpuArchitecture();
+    build["kernel"]  = QSysInfo::kernelVersion();
+    build["host"]    = QSysInfo::machineHostName();
+#ifdef QT_NO_DEBUG
+    build["release"] = true;
+#else
+    build["release"] = false;
+#endif
+
+    QJsonObject doc;
+    doc["generatedAt"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    doc["build"]       = build;
+    doc["quick"]       = h.options().quick;
+    doc["results"]     = h.toJson();
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    f.write(QJsonDocument(doc).toJson());
+    return f.commit();
+}
+
+int main(int argc, char *argv[]){
+    QCoreApplication app(argc, argv);
+
+    Bench::Options opts;
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        const QString &a = args[i];
+        const bool hasValue = i + 1 < args.size();
+        if      (a == "--quick")                opts.quick = true;
+        else if (a == "--filter" && hasValue)   opts.filter = args[++i];
+        else if (a == "--json"   && hasValue)   opts.jsonPath = args[++i];
+        else if (a == "--min-ms" && hasValue)   opts.minNs = qMax(1, args[++i].toInt()) * 1000000LL;
+        else {
+            QTextStream(stderr) << "usage: cloud_bench [--filter SUBSTR] [--quick]"
+                                   " [--min-ms N] [--json FILE]\n";
+            return 2;
+        }
+    }
+    if (opts.quick && opts.minNs == Bench::Options().minNs) opts.minNs = 50000000;
+
+    Bench::Harness h(opts);
+    Bench::klineCases(h);
+    Bench::engineCases(h);
+    Bench::accountCases(h);
+
+    if (!opts.jsonPath.isEmpty() && !writeJson(opts.jsonPath, h)) {
+        QTextStream(stderr) << "cannot write " << opts.jsonPath << "\n";
+        return 1;
+    }
+    return 0;
+}
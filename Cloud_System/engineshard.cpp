@@ -0,0 +1,313 @@
+/* =========================================================================
+   EngineShard.cpp – implementation of EngineShard.h
+   -------------------------------------------------------------------------
+   Fills, marks, triggers and serialises positions for the users this
+   shard owns. Persistence and socket I/O are handed back to TradeServer.
+   ========================================================================= */
+
+#include "engineshard.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtDebug>
+
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+EngineShard::EngineShard(int index, const QString &journalDir, QObject *parent)
+    : QObject(parent),
+    shardIndex(index),
+    tradeIds(index),
+    journal(journalDir, index)
+{
+}
+
+EngineShard::~EngineShard(){
+    for (const QSet<Trade*> &trades : usersTradeMap)
+        qDeleteAll(trades);
+}
+
+/* ------------------------------------------------------------------------
+   Start‑up: re‑index the positions recovered from the journals (marked at
+   their open price until the first tick), then open this shard's journal
+   with a snapshot of them and arm the periodic snapshot.
+   ------------------------------------------------------------------------ */
+void EngineShard::restore(const QList<JournalPosition> &positions){
+    for (const JournalPosition &p : positions) {
+        Trade *t = new Trade(p.tradeID, p.stopLoss, p.takeProfit, p.size,
+                             p.asset, p.openPrice, p.type, p.side);
+        indexTrade(p.userID, t, livePrices.value(p.asset, p.openPrice));
+    }
+    if (!journal.open(openPositions())) return;
+
+    bool ok = false;
+    int  secs = qEnvironmentVariableIntValue("JOURNAL_SNAPSHOT_S", &ok);
+    if (!ok || secs <= 0) secs = TradeJournal::DEFAULT_SNAPSHOT_S;
+    snapshotTimer = new QTimer(this);
+    connect(snapshotTimer, &QTimer::timeout, this, [this]() {
+        if (journal.needsSnapshot()) snapshotJournal();
+    });
+    snapshotTimer->start(secs * 1000);
+}
+
+/* Copy only – the file is written by the journal‑sync thread. */
+void EngineShard::snapshotJournal(){
+    journal.requestSnapshot(openPositions());
+}
+
+QList<JournalPosition> EngineShard::openPositions() const{
+    QList<JournalPosition> out;
+    out.reserve(tradesById.size());
+    for (auto it = usersTradeMap.cbegin(); it != usersTradeMap.cend(); ++it)
+        for (const Trade *t : it.value())
+            out << TradeJournal::position(it.key(), *t);
+    return out;
+}
+
+void EngineShard::pinToCpu(int cpu){
+#ifdef Q_OS_LINUX
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof set, &set) == 0) {
+        qDebug() << "[EngineShard]" << shardIndex << "pinned to CPU" << cpu;
+        return;
+    }
+#endif
+    qWarning() << "[EngineShard]" << shardIndex << "could not pin to CPU" << cpu;
+}
+
+void EngineShard::setSessionFormats(int uid, SessionFormats f){
+    if (f.any()) {
+        sessions.insert(uid, f);
+        return;
+    }
+    /* last dashboard gone – forget it and anything queued for it */
+    sessions.remove(uid);
+    for (auto it = dirtyPositions.begin(); it != dirtyPositions.end(); ) {
+        if (it->first == uid) it = dirtyPositions.erase(it);
+        else                  ++it;
+    }
+}
+
+/* ------------------------------------------------------------------------
+   One batch per market‑ring drain, applied in arrival order. Each tick only
+   marks its holders dirty; equity and "positions" frames go out once per
+   user (per user × asset) when the batch is done.
+   ------------------------------------------------------------------------ */
+void EngineShard::onPriceTicks(const QList<PriceTick> &ticks){
+    for (const PriceTick &t : ticks)
+        onPriceTick(t.first, t.second);
+    flushDirty();
+}
+
+void EngineShard::onPriceTick(Asset asset, double px){
+    livePrices[asset] = px;
+
+    checkLimits(asset);
+    positionStores[asset].markToMarket(px);
+
+    /* reverse index: only users holding the ticking asset */
+    for (int uid : exposure.holders(asset)) {
+        dirtyUsers.insert(uid);
+        if (sessions.contains(uid))
+            dirtyPositions.insert({ uid, static_cast<int>(asset) });
+    }
+}
+
+void EngineShard::flushDirty(){
+    for (int uid : std::as_const(dirtyUsers))
+        emit equityUpdate(uid, getTotalPnL(uid));
+    for (const QPair<int, int> &d : std::as_const(dirtyPositions))
+        tradeDashboardUpdate(d.first, static_cast<Asset>(d.second));
+    dirtyUsers.clear();
+    dirtyPositions.clear();
+}
+
+/* Risk‑check, then fill at the shard's live price and index the position */
+void EngineShard::openTrade(const Wire::NewTrade &m, const AccountRecord &acc){
+    const int    uid   = m.userID;
+    const Asset  asset = static_cast<Asset>(m.asset);
+    const double open  = livePrices.value(asset, 0.0);
+
+    const RiskVerdict v = riskGate.check(m, open, acc, getTotalPnL(uid),
+                                         exposure.openPositions(uid),
+                                         exposure.positions(uid, asset));
+    if (v != RiskVerdict::Accepted) {
+        emit orderAck(uid, m.clientOrderID, 0, v);
+        return;
+    }
+
+    const TradeId id = tradeIds.next();
+    Trade *t = new Trade(id, m.stopLoss, m.takeProfit, m.size, asset,
+                         open, Trade::orderTypeFromString(m.orderType),
+                         static_cast<TradeSide>(m.side));
+    indexTrade(uid, t, open);
+    if (!journal.opened(uid, *t)) snapshotJournal();
+
+    emit orderAck(uid, m.clientOrderID, id, v);
+
+    TradeEvent e;
+    e.kind      = TradeEvent::Opened;
+    e.userID    = uid;
+    e.tradeID   = id;
+    e.asset     = asset;
+    e.size      = m.size;
+    e.openPrice = open;
+    e.at        = QDateTime::currentDateTime();
+    emit tradeEvent(e);
+}
+
+void EngineShard::indexTrade(int uid, Trade *t, double px){
+    const Asset asset = t->getAsset();
+    usersTradeMap[uid].insert(t);
+    tradesById.insert(t->getTradeID(), t);
+    positionStores[asset].add(t, px);
+    triggerBooks[asset].add(uid, t);
+    exposure.add(uid, asset, signedSize(t), t->getOpenPrice());
+}
+
+/* ------------------------- PnL helpers --------------------------------- */
+double EngineShard::signedSize(const Trade *t){
+    return t->isLong() ? t->getSize() : -t->getSize();
+}
+
+/* O(#assets held) – read straight off the exposure aggregates */
+double EngineShard::getTotalPnL(int uid) const{
+    return exposure.unrealisedPnL(uid, livePrices);
+}
+
+/* Pop only the SL/TP levels the new price crossed. Closed by id: a close
+   may cascade (account lock → close‑all) and delete later hits. */
+void EngineShard::checkLimits(Asset asset){
+    const double px = livePrices[asset];
+    for (const TriggerBook::Trigger &hit : triggerBooks[asset].collect(px))
+        closeTrade(hit.userID, hit.tradeID);
+}
+
+/* ------------------------------------------------------------------------
+   One "positions" frame carrying every open trade the user holds in
+   @p asset – one serialisation per negotiated format, not per trade.
+   ------------------------------------------------------------------------ */
+void EngineShard::tradeDashboardUpdate(int uid, Asset asset){
+    const SessionFormats f = sessions.value(uid);
+    if (!f.any()) return;
+
+    const PositionStore &store = positionStores[asset];
+    QJsonArray      trades;
+    Wire::Positions batch;
+    batch.userID = uid;
+    batch.asset  = static_cast<int>(asset);
+
+    for (Trade *t : usersTradeMap.value(uid)) {
+        if (t->getAsset() != asset) continue;
+
+        if (f.json) {
+            QJsonObject obj;
+            obj["tradeID"]    = t->getTradeIDString();
+            obj["stopLoss"]   = t->getStopLoss();
+            obj["takeProfit"] = t->getTakeProfit();
+            obj["size"]       = t->getSize();
+            obj["asset"]      = static_cast<int>(asset);
+            obj["openPrice"]  = t->getOpenPrice();
+            obj["position"]   = t->getPosition();
+            obj["pnl"]        = store.pnl(t);
+            trades.append(obj);
+        }
+        if (f.binary) {
+            Wire::Position p;
+            p.tradeID    = t->getTradeID();
+            p.side       = static_cast<Wire::Side>(t->side());
+            p.stopLoss   = t->getStopLoss();
+            p.takeProfit = t->getTakeProfit();
+            p.size       = t->getSize();
+            p.openPrice  = t->getOpenPrice();
+            p.pnl        = store.pnl(t);
+            batch.trades << p;
+        }
+    }
+    if (trades.isEmpty() && batch.trades.isEmpty()) return;
+
+    QString json;
+    if (f.json) {
+        QJsonObject obj;
+        obj["type"]   = "positions";
+        obj["userID"] = uid;
+        obj["asset"]  = static_cast<int>(asset);
+        obj["trades"] = trades;
+        json = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+    }
+    emit dashboardPush(uid, json, f.binary ? Wire::encode(batch) : QByteArray());
+}
+
+/* ------------------------------------------------------------------ */
+void EngineShard::closeTrade(int uid, TradeId tid){
+    Trade *t = tradesById.value(tid);
+    if (!t) return;                               // already closed
+    auto owner = usersTradeMap.constFind(uid);
+    if (owner == usersTradeMap.cend() || !owner.value().contains(t)) return;
+    closeTrade(uid, t);
+}
+
+void EngineShard::closeTrade(int uid, Trade *t){
+    const TradeId tid   = t->getTradeID();
+    const Asset   asset = t->getAsset();
+
+    double live = livePrices[asset];
+    double diff = t->isLong()
+                      ? (live - t->getOpenPrice())
+                      : (t->getOpenPrice() - live);
+    double pnl  = diff * t->getSize();
+
+    TradeEvent e;
+    e.kind       = TradeEvent::Closed;
+    e.userID     = uid;
+    e.tradeID    = tid;
+    e.asset      = asset;
+    e.size       = t->getSize();
+    e.openPrice  = t->getOpenPrice();
+    e.closePrice = live;
+    e.pnl        = pnl;
+    e.at         = QDateTime::currentDateTime();
+
+    triggerBooks[asset].remove(t);
+    positionStores[asset].remove(t);
+    exposure.remove(uid, asset, signedSize(t), t->getOpenPrice());
+    QSet<Trade*> &owned = usersTradeMap[uid];
+    owned.remove(t);
+    if (owned.isEmpty()) usersTradeMap.remove(uid);
+    tradesById.remove(tid);
+    delete t;
+    if (!journal.closed(uid, tid)) snapshotJournal();
+
+    emit tradeEvent(e);
+    emit equityUpdate(uid, getTotalPnL(uid));
+
+    /* notify live dashboards that the trade is gone */
+    const SessionFormats f = sessions.value(uid);
+    if (f.any()) {
+        QString json;
+        if (f.json) {
+            QJsonObject obj;
+            obj["type"]    = "closed";
+            obj["userID"]  = uid;
+            obj["tradeID"] = TradeIds::toString(tid);
+            obj["pnl"]     = pnl;
+            json = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+        }
+        QByteArray bin;
+        if (f.binary) bin = Wire::encode(Wire::Closed{ uid, tid, pnl });
+        emit dashboardPush(uid, json, bin);
+    }
+}
+
+/* By id for the same reason as checkLimits(): a close can re‑enter here */
+void EngineShard::closeAllTrades(int uid){
+    QList<TradeId> open;
+    for (Trade *t : usersTradeMap.value(uid)) open << t->getTradeID();
+    for (TradeId tid : open)
+        closeTrade(uid, tid);
+}
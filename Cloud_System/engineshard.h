@@ -0,0 +1,135 @@
+/* =========================================================================
+   EngineShard.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   One partition of the trading engine: a subset of users, their open
+   positions and the risk books that watch them.
+
+   Key features
+   • Owns private usersTradeMap / PositionStores / TriggerBooks / live
+     prices – nothing is shared with other shards, so there are no locks.
+   • Every tick is delivered to every shard (onPriceTicks); each shard
+     marks, triggers and serialises only its own users.
+   • Per‑user equity comes from an ExposureBook (net qty + entry notional
+     per asset), so getTotalPnL() is O(#assets), not O(#trades).
+   • Tick fan‑out walks the ExposureBook's asset → holders index and only
+     marks those users dirty; a batch ends with one equityUpdate per dirty
+     user and one "positions" frame per dirty (user, asset) with a live
+     dashboard. Non‑holders cost nothing.
+   • Orders and closes for a user always land on the same shard
+     (TradeServer routes by userID % shardCount).
+   • Every order passes the RiskGate before it is filled – equity and
+     position counts come straight off the ExposureBook, the account row
+     is snapshotted by TradeServer – and is answered with orderAck.
+   • Fills are stamped with a TradeId from the shard's own generator (node
+     = shard index), and tradesById finds a trade for a close in O(1).
+   • Outbound traffic is emitted, not sent: dashboardPush / equityUpdate /
+     tradeEvent are queued back to TradeServer, which owns the sockets and
+     the database connection.
+   • Fills and closes are appended to the shard's TradeJournal before the
+     orderAck / tradeEvent go out; restore() rebuilds the books from
+     recovered positions at start‑up and a snapshot is requested every
+     $JOURNAL_SNAPSHOT_S – the shard only copies its positions, the
+     journal‑sync thread writes the file (see TradeJournal.h).
+
+   Design notes
+   • Lives on its own QThread (or inline on TradeServer's thread when the
+     engine runs with a single shard). All public methods must run on the
+     shard's thread – callers go through QMetaObject::invokeMethod.
+   • Ticks and orders share one event queue per shard, so a user's order
+     is always filled at the price of the ticks that preceded it.
+   • The dirty sets are kept in sync with the indexes: closes leave at
+     most a harmless empty update, a dashboard disconnect
+     (setSessionFormats with no formats) drops the user's pending frames.
+   • pinToCpu() is best effort: Linux only, failure is logged and ignored.
+   ========================================================================= */
+
+#ifndef ENGINESHARD_H
+#define ENGINESHARD_H
+
+#include "trade.h"
+#include "triggerbook.h"
+#include "positionstore.h"
+#include "exposurebook.h"
+#include "riskgate.h"
+#include "tradeevent.h"
+#include "tradejournal.h"
+#include "wireprotocol.h"
+
+#include <QObject>
+#include <QHash>
+#include <QMap>
+#include <QList>
+#include <QPair>
+#include <QSet>
+#include <QTimer>
+#include <map>
+
+/* Encodings wanted by a user's live dashboard sessions */
+struct SessionFormats {
+    bool json   = false;
+    bool binary = false;
+    bool any() const { return json || binary; }
+};
+
+class EngineShard : public QObject
+{
+    Q_OBJECT
+public:
+    using PriceTick = QPair<Asset, double>;
+
+    EngineShard(int index, const QString &journalDir, QObject *parent = nullptr);
+    ~EngineShard();
+
+    int index() const { return shardIndex; }
+
+    /* Any thread – TradeServer's sync timer flushes it in the background. */
+    TradeJournal *tradeJournal() { return &journal; }
+
+    /* ---- shard‑thread API ---------------------------------------------- */
+    void restore(const QList<JournalPosition> &positions);
+    void onPriceTicks(const QList<PriceTick> &ticks);
+    void openTrade(const Wire::NewTrade &order, const AccountRecord &account);
+    void closeTrade(int userID, TradeId tradeID);
+    void closeAllTrades(int userID);
+    void setSessionFormats(int userID, SessionFormats formats);
+    void pinToCpu(int cpu);
+
+    double getTotalPnL(int userID) const;
+    std::vector<Exposure> exposures(int userID) const { return exposure.exposures(userID); }
+
+signals:
+    void equityUpdate(int userID, double totalPnL);
+    void tradeEvent(const TradeEvent &event);
+    void orderAck(int userID, quint64 clientOrderID, TradeId tradeID,
+                  RiskVerdict verdict);
+    /* Pre‑encoded dashboard payload; either half may be empty. */
+    void dashboardPush(int userID, const QString &json, const QByteArray &binary);
+
+private:
+    void onPriceTick(Asset asset, double price);
+    void flushDirty();
+    void checkLimits(Asset asset);
+    void tradeDashboardUpdate(int userID, Asset asset);
+    void closeTrade(int userID, Trade *trade);
+    void indexTrade(int userID, Trade *trade, double markPrice);
+    void snapshotJournal();
+    QList<JournalPosition> openPositions() const;
+    static double signedSize(const Trade *trade);
+
+    int                               shardIndex;
+    QMap<int, QSet<Trade*>>           usersTradeMap;
+    QHash<TradeId, Trade*>            tradesById;
+    TradeIds::Generator               tradeIds;
+    QHash<int, SessionFormats>        sessions;
+    QMap<Asset, double>               livePrices;
+    std::map<Asset, TriggerBook>      triggerBooks;
+    QMap<Asset, PositionStore>        positionStores;
+    ExposureBook                      exposure;
+    RiskGate                          riskGate;
+    TradeJournal                      journal;
+    QTimer                           *snapshotTimer {nullptr};
+    QSet<int>                         dirtyUsers;      // equity to emit
+    QSet<QPair<int, int>>             dirtyPositions;  // (userID, asset) frames
+};
+
+#endif // ENGINESHARD_H
@@ -0,0 +1,85 @@
+/* =========================================================================
+   ExposureBook.cpp – implementation of ExposureBook.h
+   -------------------------------------------------------------------------
+   O(1) aggregate maintenance on open / close, O(#assets) valuation.
+   ========================================================================= */
+
+#include "exposurebook.h"
+
+void ExposureBook::add(int uid, Asset asset, double q, double px){
+    ++openCount[uid];
+    std::vector<Exposure> &row = rows[uid];
+    for (Exposure &e : row) {
+        if (e.asset != asset) continue;
+        e.netQty        += q;
+        e.entryNotional += q * px;
+        ++e.positions;
+        return;
+    }
+    row.push_back({ asset, q, q * px, 1 });
+    holdersOf[asset].insert(uid);
+}
+
+void ExposureBook::remove(int uid, Asset asset, double q, double px){
+    auto it = rows.find(uid);
+    if (it == rows.end()) return;
+
+    std::vector<Exposure> &row = it.value();
+    for (std::size_t i = 0; i < row.size(); ++i) {
+        Exposure &e = row[i];
+        if (e.asset != asset) continue;
+
+        auto c = openCount.find(uid);
+        if (c != openCount.end() && --c.value() <= 0) openCount.erase(c);
+
+        if (--e.positions <= 0) {                   // flat – drop residue
+            row[i] = row.back();
+            row.pop_back();
+            if (row.empty()) rows.erase(it);
+
+            auto h = holdersOf.find(asset);
+            if (h != holdersOf.end()) {
+                h.value().remove(uid);
+                if (h.value().isEmpty()) holdersOf.erase(h);
+            }
+        } else {
+            e.netQty        -= q;
+            e.entryNotional -= q * px;
+        }
+        return;
+    }
+}
+
+double ExposureBook::unrealisedPnL(int uid, const QMap<Asset, double> &prices) const{
+    auto it = rows.constFind(uid);
+    if (it == rows.cend()) return 0.0;
+
+    double tot = 0.0;
+    for (const Exposure &e : it.value()) {
+        auto px = prices.constFind(e.asset);
+        if (px != prices.cend()) tot += e.unrealised(px.value());
+    }
+    return tot;
+}
+
+bool ExposureBook::holds(int uid, Asset asset) const{
+    auto it = rows.constFind(uid);
+    if (it == rows.cend()) return false;
+    for (const Exposure &e : it.value())
+        if (e.asset == asset) return true;
+    return false;
+}
+
+int ExposureBook::positions(int uid, Asset asset) const{
+    auto it = rows.constFind(uid);
+    if (it == rows.cend()) return 0;
+    for (const Exposure &e : it.value())
+        if (e.asset == asset) return e.positions;
+    return 0;
+}
+
+const QSet<int> &ExposureBook::holders(Asset asset) const{
+    static const QSet<int> none;
+    auto it = holdersOf.constFind(asset);
+    return it == holdersOf.cend() ? none : it.value();
+}
@@ -0,0 +1,75 @@
+/* =========================================================================
+   ExposureBook.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Running per‑user, per‑asset net exposure.
+
+   Key features
+   • For every (user, asset) keeps the net signed quantity Q (long +,
+     short −) and the signed entry notional N = Σ qᵢ · entryᵢ.
+   • Unrealised PnL of the whole book at price px is simply Q·px − N, so a
+     user's total PnL costs O(#assets held), independent of trade count.
+   • Average entry (N / Q) and gross / net exposure fall out of the same
+     two numbers – the basis for exposure reporting.
+   • Reverse index asset → holders, maintained as rows appear / vanish, so
+     a tick only has to visit users with a position in that asset.
+   • Per‑user and per‑(user, asset) open position counts for the pre‑trade
+     RiskGate.
+
+   Design notes
+   • add() / remove() are exact inverses; when a user's last position in
+     an asset closes, the entry is dropped outright so floating‑point
+     residue never accumulates across trades.
+   • Users hold a handful of assets, so each user's row is a tiny vector
+     scanned linearly rather than a nested hash.
+   • Not thread‑safe – one instance per EngineShard.
+   ========================================================================= */
+
+#ifndef EXPOSUREBOOK_H
+#define EXPOSUREBOOK_H
+
+#include "asset.h"
+
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <vector>
+
+struct Exposure {
+    Asset  asset         = BTCUSDT;
+    double netQty        = 0.0;     // Σ signed size
+    double entryNotional = 0.0;     // Σ signed size × open price
+    int    positions     = 0;
+
+    double unrealised(double px) const { return netQty * px - entryNotional; }
+    double avgEntry()            const { return netQty != 0.0 ? entryNotional / netQty : 0.0; }
+};
+
+class ExposureBook
+{
+public:
+    /* @p signedQty is +size for longs, −size for shorts. */
+    void add   (int userID, Asset asset, double signedQty, double entryPrice);
+    void remove(int userID, Asset asset, double signedQty, double entryPrice);
+
+    /* Σ over the user's assets of Q·px − N (assets without a price are skipped). */
+    double unrealisedPnL(int userID, const QMap<Asset, double> &prices) const;
+
+    /* Per‑asset rows of @p userID (empty if flat). */
+    std::vector<Exposure> exposures(int userID) const { return rows.value(userID); }
+
+    bool holds(int userID, Asset asset) const;
+
+    /* Open trades of @p userID in @p asset / across all assets. */
+    int positions(int userID, Asset asset) const;
+    int openPositions(int userID) const { return openCount.value(userID); }
+
+    /* Users with at least one open position in @p asset. */
+    const QSet<int> &holders(Asset asset) const;
+
+private:
+    QHash<int, std::vector<Exposure>> rows;
+    QHash<int, QSet<int>>             holdersOf;   // asset → userIDs
+    QHash<int, int>                   openCount;   // userID → open trades
+};
+
+#endif // EXPOSUREBOOK_H
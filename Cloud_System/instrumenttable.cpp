@@ -0,0 +1,64 @@
+/* =========================================================================
+   InstrumentTable.cpp – implementation of InstrumentTable.h
+   ========================================================================= */
+
+#include "instrumenttable.h"
+#include "klinedecoder.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtDebug>
+
+InstrumentTable::InstrumentTable(){
+    append("BTCUSDT");   // Asset::BTCUSDT
+    append("ETHUSDT");   // Asset::ETHUSDT
+    append("SOLUSDT");   // Asset::SOLUSDT
+    append("XRPUSDT");   // Asset::XRPUSDT
+}
+
+void InstrumentTable::append(const QString &sym){
+    const QString upper = sym.trimmed().toUpper();
+    const quint64 hash  = KlineDecoder::symbolHash(upper);
+    if (upper.isEmpty() || byHash.contains(hash)) return;
+
+    Instrument in;
+    in.id     = static_cast<Asset>(table.size());
+    in.symbol = upper;
+    in.stream = upper.toLower() + "@kline_1m";
+
+    byHash.insert(hash, in.id);
+    table << in;
+}
+
+bool InstrumentTable::load(const QString &path){
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        qWarning() << "[InstrumentTable] cannot open" << path;
+        return false;
+    }
+
+    const QJsonDocument d = QJsonDocument::fromJson(f.readAll());
+    if (!d.isObject() || !d.object().value("symbols").isArray()) {
+        qWarning() << "[InstrumentTable] bad format in" << path;
+        return false;
+    }
+
+    for (const QJsonValue &v : d.object().value("symbols").toArray())
+        append(v.toString());
+
+    qDebug() << "[InstrumentTable]" << table.size() << "instruments loaded";
+    return true;
+}
+
+bool InstrumentTable::lookup(quint64 hash, Asset &out) const{
+    auto it = byHash.constFind(hash);
+    if (it == byHash.cend()) return false;
+    out = it.value();
+    return true;
+}
+
+QString InstrumentTable::symbol(Asset id) const{
+    return (id >= 0 && id < table.size()) ? table[id].symbol : QString();
+}
@@ -0,0 +1,62 @@
+/* =========================================================================
+   InstrumentTable.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Data‑driven list of the symbols the cloud engine trades.
+
+   Key features
+   • The four built‑in symbols (BTC, ETH, SOL, XRP) always occupy ids 0‑3
+     so they stay wire‑compatible with the desktop client's Asset enum.
+   • Extra symbols come from a JSON file and are appended in file order,
+     each getting the next integer id – adding a pair no longer needs a
+     recompile.
+   • O(1) look‑ups in both directions: id → Instrument and symbol hash →
+     id (KlineDecoder::symbolHash, used to route frames without building a
+     QString per tick).
+
+   File format (path taken from $CLOUD_INSTRUMENTS)
+       { "symbols": [ "BTCUSDT", "ETHUSDT", "BNBUSDT", "ADAUSDT", … ] }
+   Duplicates and the built‑ins are ignored; case does not matter.
+   ========================================================================= */
+
+#ifndef INSTRUMENTTABLE_H
+#define INSTRUMENTTABLE_H
+
+#include "asset.h"
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+struct Instrument {
+    Asset   id;
+    QString symbol;   // exchange symbol, upper case  – "BTCUSDT"
+    QString stream;   // combined‑stream name         – "btcusdt@kline_1m"
+};
+
+class InstrumentTable
+{
+public:
+    /* Built‑in four symbols only. */
+    InstrumentTable();
+
+    /* Append the symbols listed in the JSON file at @p path.
+       @return false if the file is missing or malformed (table unchanged). */
+    bool load(const QString &path);
+
+    const QList<Instrument> &instruments() const { return table; }
+    int  size() const { return table.size(); }
+
+    /* Route a decoded frame by KlineFrame::symbolHash.
+       @return false if unknown. */
+    bool lookup(quint64 symbolHash, Asset &out) const;
+
+    QString symbol(Asset id) const;
+
+private:
+    void append(const QString &symbol);
+
+    QList<Instrument>      table;     // id == index
+    QHash<quint64, Asset>  byHash;    // symbol hash → id
+};
+
+#endif // INSTRUMENTTABLE_H
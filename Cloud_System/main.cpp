@@ -4,9 +4,50 @@
 #include "tradeserver.h"
 #include "DatabaseManager.h"
 
+#ifdef Q_OS_UNIX
+#include <QSocketNotifier>
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/* SIGINT / SIGTERM → QCoreApplication::quit() via a self‑pipe: the handler
+   only write()s (async‑signal‑safe), the event loop does the rest. */
+static int signalFd[2] = { -1, -1 };
+
+static void onSignal(int){
+    const char c = 1;
+    [[maybe_unused]] const ssize_t n = ::write(signalFd[0], &c, 1);
+}
+
+static void installSignalHandlers(QCoreApplication &app){
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, signalFd) != 0) {
+        qWarning() << "[main] socketpair failed – SIGINT / SIGTERM not handled";
+        return;
+    }
+    auto *notifier = new QSocketNotifier(signalFd[1], QSocketNotifier::Read, &app);
+    QObject::connect(notifier, &QSocketNotifier::activated, &app, [notifier]() {
+        notifier->setEnabled(false);
+        char c;
+        [[maybe_unused]] const ssize_t n = ::read(signalFd[1], &c, 1);
+        qDebug() << "[main] signal received – shutting down";
+        QCoreApplication::quit();
+    });
+
+    struct sigaction sa {};
+    sa.sa_handler = onSignal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGINT,  &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+}
+#endif
+
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
+#ifdef Q_OS_UNIX
+    installSignalHandlers(app);
+#endif
 
     qDebug() << "Available SQL drivers:" << QSqlDatabase::drivers();
     if (!DatabaseManager::getInstance().initialize()) {
@@ -24,5 +65,17 @@ int main(int argc, char *argv[])
 
     tradeServer->setAccountServer(accountServer);
 
+    /* Orderly shutdown: TradeServer first (joins shards, drains / spills
+       the TradeWriter, flushes analytics), then the account ledger is
+       flushed explicitly and AccountServer goes. */
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, [&]() {
+        delete tradeServer;
+        tradeServer = nullptr;
+        accountServer->flushLedger();
+        delete accountServer;
+        accountServer = nullptr;
+        qDebug() << "Cloud shut down cleanly";
+    });
+
     return app.exec();
 }
@@ -0,0 +1,246 @@
+/* =========================================================================
+   MarketCapture.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Record / replay of raw market‑data frames for benchmarking the tick path
+   and reproducing busy sessions deterministically.
+
+   Key features
+   • Capture file ("RMCAP"): a 32‑byte header, then one record per frame
+         i64 recvNs | i32 symbol | u32 length | <length> bytes UTF‑8 frame
+     little‑endian. recvNs is the monotonic receive time, symbol the
+     Asset id the frame routed to (‑1 = unknown / undecodable).
+   • Capture::Writer appends through a buffered QFile – one memcpy per
+     frame on the receiving thread; flushed on close.
+   • Capture::Reader streams records back in file order.
+   • Capture::Replayer pushes the file into a sink at 1×, N× (speed) or
+     max speed (speed <= 0), keeping the original inter‑frame gaps
+     scaled by 1 / speed. A sink that returns false is retried later, so
+     a full hand‑over ring delays the replay instead of dropping ticks.
+
+   Design notes
+   • Frames are stored verbatim, not decoded, so a replay runs the exact
+     decode → route → hand‑over path a live session does.
+   • The header records which feed wrote it (Source) and the wall‑clock
+     start, so a capture can be matched to logs after an incident.
+   • The replayer owns a QTimer: create it on the thread that should run
+     the sink (e.g. inside MarketDataFeed::start()).
+   • Header‑only; mirrored in Cloud_System/ and trading_system_qt/Common/
+     services/ – keep the two copies in sync.
+   ========================================================================= */
+
+#ifndef MARKETCAPTURE_H
+#define MARKETCAPTURE_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <QTimer>
+#include <QtDebug>
+#include <QtEndian>
+
+#include <cstring>
+#include <functional>
+
+namespace Capture {
+
+constexpr char    MAGIC[6]      = { 'R', 'M', 'C', 'A', 'P', '\0' };
+constexpr quint16 VERSION       = 1;
+constexpr int     HEADER_SIZE   = 32;
+constexpr int     RECORD_HEADER = 16;
+constexpr quint32 MAX_FRAME     = 1u << 20;   // sanity bound on read
+constexpr int     REPLAY_BATCH  = 512;        // frames per event‑loop turn
+
+enum class Source : quint16 { CloudFeed = 0, ChartFeed = 1 };
+
+struct Record {
+    qint64     recvNs = 0;
+    qint32     symbol = -1;
+    QByteArray frame;
+};
+
+/* ------------------------------ writer --------------------------------- */
+class Writer
+{
+public:
+    ~Writer() { close(); }
+
+    bool open(const QString &path, Source source){
+        close();
+        file.setFileName(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qWarning() << "[Capture] cannot write" << path << file.errorString();
+            return false;
+        }
+        char h[HEADER_SIZE] = {};
+        std::memcpy(h, MAGIC, sizeof MAGIC);
+        qToLittleEndian<quint16>(VERSION, h + 6);
+        qToLittleEndian<quint16>(static_cast<quint16>(source), h + 8);
+        qToLittleEndian<qint64>(QDateTime::currentMSecsSinceEpoch(), h + 16);
+        file.write(h, HEADER_SIZE);
+        frames = 0;
+        qDebug() << "[Capture] recording to" << path;
+        return true;
+    }
+
+    bool isOpen() const { return file.isOpen(); }
+
+    void write(qint64 recvNs, qint32 symbol, const QString &frame){
+        write(recvNs, symbol, frame.toUtf8());
+    }
+
+    void write(qint64 recvNs, qint32 symbol, const QByteArray &frame){
+        if (!file.isOpen()) return;
+        char h[RECORD_HEADER];
+        qToLittleEndian<qint64>(recvNs, h);
+        qToLittleEndian<qint32>(symbol, h + 8);
+        qToLittleEndian<quint32>(quint32(frame.size()), h + 12);
+        file.write(h, RECORD_HEADER);
+        file.write(frame);
+        ++frames;
+    }
+
+    void close(){
+        if (!file.isOpen()) return;
+        file.close();
+        qDebug() << "[Capture] wrote" << frames << "frames to" << file.fileName();
+    }
+
+    quint64 written() const { return frames; }
+
+private:
+    QFile   file;
+    quint64 frames {0};
+};
+
+/* ------------------------------ reader --------------------------------- */
+class Reader
+{
+public:
+    bool open(const QString &path){
+        file.setFileName(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qWarning() << "[Capture] cannot read" << path << file.errorString();
+            return false;
+        }
+        char h[HEADER_SIZE];
+        if (file.read(h, HEADER_SIZE) != HEADER_SIZE ||
+            std::memcmp(h, MAGIC, sizeof MAGIC) != 0 ||
+            qFromLittleEndian<quint16>(h + 6) != VERSION) {
+            qWarning() << "[Capture] not a capture file:" << path;
+            file.close();
+            return false;
+        }
+        src     = static_cast<Source>(qFromLittleEndian<quint16>(h + 8));
+        started = qFromLittleEndian<qint64>(h + 16);
+        return true;
+    }
+
+    /* false at end of file or on a truncated tail */
+    bool next(Record &r){
+        char h[RECORD_HEADER];
+        if (file.read(h, RECORD_HEADER) != RECORD_HEADER) return false;
+        r.recvNs = qFromLittleEndian<qint64>(h);
+        r.symbol = qFromLittleEndian<qint32>(h + 8);
+        const quint32 len = qFromLittleEndian<quint32>(h + 12);
+        if (len > MAX_FRAME) return false;
+        r.frame = file.read(len);
+        return r.frame.size() == qsizetype(len);
+    }
+
+    Source source()    const { return src; }
+    qint64 startedAt() const { return started; }   // ms since epoch, UTC
+
+private:
+    QFile  file;
+    Source src     {Source::CloudFeed};
+    qint64 started {0};
+};
+
+/* ----------------------------- replayer -------------------------------- */
+class Replayer
+{
+public:
+    /* Sink returns false when it cannot take the frame yet. */
+    using Sink = std::function<bool(const Record &)>;
+
+    explicit Replayer(Sink sink) : sink(std::move(sink)){
+        timer.setSingleShot(true);
+        timer.setTimerType(Qt::PreciseTimer);
+        QObject::connect(&timer, &QTimer::timeout, [this]() { step(); });
+    }
+
+    bool start(const QString &path, double replaySpeed){
+        if (!reader.open(path)) return false;
+        speed    = replaySpeed;
+        frames   = 0;
+        stalls   = 0;
+        pending  = reader.next(current);
+        firstNs  = current.recvNs;
+        clock.start();
+        qDebug() << "[Capture] replaying" << path << "at"
+                 << (speed > 0 ? QString::number(speed) + "x" : QString("max speed"));
+        timer.start(0);
+        return true;
+    }
+
+    bool    running()  const { return pending; }
+    quint64 replayed() const { return frames; }
+
+private:
+    /* Deliver every frame that is due, then sleep until the next one. */
+    void step(){
+        int batch = 0;
+        while (pending) {
+            if (speed > 0) {
+                const qint64 dueNs  = qint64((current.recvNs - firstNs) / speed);
+                const qint64 waitMs = (dueNs - clock.nsecsElapsed()) / 1000000;
+                if (waitMs > 0) { timer.start(int(qMin<qint64>(waitMs, 1000))); return; }
+            }
+            if (++batch > REPLAY_BATCH) {
+                timer.start(0);                  // let the consumer drain
+                return;
+            }
+            if (!sink(current)) {                // back‑pressure – retry
+                ++stalls;
+                timer.start(1);
+                return;
+            }
+            ++frames;
+            pending = reader.next(current);
+        }
+        const double secs = clock.nsecsElapsed() / 1e9;
+        qDebug() << "[Capture] replay finished:" << frames << "frames in"
+                 << secs << "s (" << (secs > 0 ? frames / secs : 0.0)
+                 << "frames/s," << stalls << "stalls )";
+    }
+
+    Sink          sink;
+    Reader        reader;
+    Record        current;
+    bool          pending {false};
+    double        speed   {1.0};
+    qint64        firstNs {0};
+    quint64       frames  {0};
+    quint64       stalls  {0};
+    QElapsedTimer clock;
+    QTimer        timer;
+};
+
+/* "max" / "0" → max speed (0), otherwise a positive multiplier, default 1× */
+inline double parseSpeed(const QString &text){
+    if (text.isEmpty()) return 1.0;
+    if (text.compare("max", Qt::CaseInsensitive) == 0) return 0.0;
+    bool ok = false;
+    const double v = text.toDouble(&ok);
+    return ok ? qMax(0.0, v) : 1.0;
+}
+
+/* Monotonic receive stamp used by both feeds */
+inline qint64 nowNs(){ return QDeadlineTimer::current().deadlineNSecs(); }
+
+} // namespace Capture
+
+#endif // MARKETCAPTURE_H
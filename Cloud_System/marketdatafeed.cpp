@@ -0,0 +1,115 @@
+/* =========================================================================
+   MarketDataFeed.cpp – implementation of MarketDataFeed.h
+   -------------------------------------------------------------------------
+   Chunks the instrument table into combined‑stream URLs, keeps the sockets
+   alive, and hands every decoded k‑line frame to the engine via SpscRing.
+   ========================================================================= */
+
+#include "marketdatafeed.h"
+
+#include <QDeadlineTimer>
+#include <QStringList>
+#include <QTimer>
+#include <QtDebug>
+
+MarketDataFeed::MarketDataFeed(const InstrumentTable &table,
+                               TickRing *tickRing,
+                               const QString &base,
+                               int streamsPerConnection,
+                               QObject *parent)
+    : QObject(parent),
+    instruments(table),
+    ring(tickRing),
+    baseUrl(base),
+    perConnection(qMax(1, streamsPerConnection))
+{
+    while (baseUrl.endsWith('/')) baseUrl.chop(1);
+}
+
+/* ------------------------------------------------------------------------
+   One socket per chunk of perConnection streams, all wired to onFrame().
+   ------------------------------------------------------------------------ */
+void MarketDataFeed::start(){
+    if (!capturePath.isEmpty())
+        capture.open(capturePath, Capture::Source::CloudFeed);
+    if (!replayPath.isEmpty()) {
+        startReplay();
+        return;
+    }
+
+    const QList<Instrument> &all = instruments.instruments();
+
+    for (int i = 0; i < all.size(); i += perConnection) {
+        QStringList streams;
+        for (int j = i; j < qMin(i + perConnection, all.size()); ++j)
+            streams << all[j].stream;
+
+        const QUrl url(baseUrl + "/stream?streams=" + streams.join('/'));
+
+        QWebSocket *ws = new QWebSocket(QString(),
+                                        QWebSocketProtocol::VersionLatest,
+                                        this);
+        connect(ws,   &QWebSocket::textMessageReceived,
+                this, &MarketDataFeed::onFrame);
+        connect(ws,   &QWebSocket::disconnected,
+                this, &MarketDataFeed::onSocketDisconnected);
+        ws->open(url);
+
+        sockets << ws;
+        urls    << url;
+    }
+    qDebug() << "[MarketDataFeed]" << all.size() << "streams over"
+             << sockets.size() << "connection(s) to" << baseUrl;
+}
+
+/* ------------------------------------------------------------------------
+   Combined ({"stream","data"}) and raw /ws frames decode the same way; the
+   "s" field inside the payload identifies the instrument.
+   ------------------------------------------------------------------------ */
+void MarketDataFeed::onFrame(const QString &frame){
+    ingest(frame, QDeadlineTimer::current().deadlineNSecs());
+}
+
+/* false only when the ring was full (the tick is dropped and counted) */
+bool MarketDataFeed::ingest(const QString &frame, qint64 recvNs){
+    MarketTick tick;
+    tick.recvNs = recvNs;
+    const bool routed = KlineDecoder::decode(frame, tick.frame) &&
+                        instruments.lookup(tick.frame.symbolHash, tick.asset);
+    if (capture.isOpen())
+        capture.write(recvNs, routed ? qint32(tick.asset) : -1, frame);
+    if (!routed) return true;
+
+    if (!ring->push(tick)) return false;           // full – counted as drop
+    std::atomic_thread_fence(std::memory_order_seq_cst);   // see ackTicksReady()
+    if (!drainPending.exchange(true, std::memory_order_acq_rel))
+        emit ticksReady();
+    return true;
+}
+
+/* ------------------------------------------------------------------------
+   Replay instead of sockets. Frames are re‑stamped with the current time,
+   so queue / tick latencies measure this run, and a full ring pauses the
+   file (the replayer retries) – what goes in is exactly what was recorded.
+   ------------------------------------------------------------------------ */
+void MarketDataFeed::startReplay(){
+    replayer = std::make_unique<Capture::Replayer>(
+        [this](const Capture::Record &r) {
+            if (ring->size() >= TickRing::capacity()) return false;
+            ingest(QString::fromUtf8(r.frame), Capture::nowNs());
+            return true;
+        });
+    if (!replayer->start(replayPath, replaySpeed))
+        qWarning() << "[MarketDataFeed] replay of" << replayPath << "failed";
+}
+
+void MarketDataFeed::onSocketDisconnected(){
+    QWebSocket *ws = qobject_cast<QWebSocket*>(sender());
+    const int idx  = sockets.indexOf(ws);
+    if (idx < 0) return;
+
+    qWarning() << "[MarketDataFeed] connection" << idx << "dropped –"
+               << "reconnecting in" << RECONNECT_MS << "ms";
+    const QUrl url = urls[idx];
+    QTimer::singleShot(RECONNECT_MS, ws, [ws, url]() { ws->open(url); });
+}
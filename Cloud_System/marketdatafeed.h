@@ -0,0 +1,120 @@
+/* =========================================================================
+   MarketDataFeed.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Multiplexed Binance k‑line ingestion driven by an InstrumentTable.
+
+   Key features
+   • One combined‑stream socket per N symbols:
+         <base>/stream?streams=btcusdt@kline_1m/ethusdt@kline_1m/…
+     so 200+ pairs cost a handful of TLS connections, not 200.
+   • Every socket feeds one slot; frames are decoded in place by
+     KlineDecoder and routed to an Asset id by their symbol hash.
+   • Runs on its own QThread: receive + decode never wait behind SQL or
+     risk work on the engine thread. Decoded MarketTicks are handed over
+     through a bounded SpscRing owned by the consumer; a full ring drops
+     the tick (counted) instead of stalling the socket.
+   • Base URL is a constructor argument, so a local stand‑in feed
+     (ws://127.0.0.1:…) works exactly like the real exchange.
+   • Record / replay (MarketCapture.h): setCapture() writes every raw
+     frame with its receive time and Asset id; setReplay() opens no
+     sockets and instead feeds a capture file through the same onFrame()
+     path at 1×, N× or max speed – a full ring then pauses the replay
+     rather than dropping ticks.
+
+   Design notes
+   • Binance caps a combined connection at 1024 streams; N defaults to 200
+     to keep individual frames‑per‑socket rates modest.
+   • A dropped socket is reopened with the same URL after RECONNECT_MS.
+   • ticksReady() is emitted once per empty→non‑empty hand‑over, not per
+     tick: the consumer calls ackTicksReady() before draining, so a burst
+     of N frames costs one queued event on the engine thread.
+   • That hand‑over is a store‑buffer (Dekker) pattern – producer: push,
+     read flag; consumer: clear flag, read ring – so both sides put a
+     seq_cst fence between their store and their load. Without them
+     either load may pass the other side's store, the consumer sees an
+     empty ring, the producer sees the flag still set, and the tick
+     sits in the ring until the next one arrives.
+   • Construct on the consumer thread, then moveToThread(); sockets are
+     created in start() so they belong to the feed thread.
+   ========================================================================= */
+
+#ifndef MARKETDATAFEED_H
+#define MARKETDATAFEED_H
+
+#include "instrumenttable.h"
+#include "klinedecoder.h"
+#include "marketcapture.h"
+#include "spscring.h"
+
+#include <QObject>
+#include <QList>
+#include <QUrl>
+#include <QWebSocket>
+
+#include <atomic>
+#include <memory>
+
+/* Decoded tick as it crosses from the feed thread to the engine. */
+struct MarketTick {
+    Asset      asset;
+    qint64     recvNs;    // monotonic ns at receive (QDeadlineTimer::current)
+    KlineFrame frame;
+};
+
+using TickRing = SpscRing<MarketTick, 16384>;
+
+class MarketDataFeed : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int RECONNECT_MS = 2000;
+
+    MarketDataFeed(const InstrumentTable &instruments,
+                   TickRing              *ring,
+                   const QString         &baseUrl,
+                   int                    streamsPerConnection = 200,
+                   QObject               *parent = nullptr);
+
+    /* Consumer side – call before draining the ring. The fence keeps the
+       ring reads after the store (pairs with the one in ingest()). */
+    void ackTicksReady() {
+        drainPending.store(false, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    /* Before start(): record raw frames to / replay them from a file. */
+    void setCapture(const QString &path) { capturePath = path; }
+    void setReplay(const QString &path, double speed) { replayPath = path; replaySpeed = speed; }
+
+public slots:
+    /* Open every combined‑stream socket (runs on the feed thread). */
+    void start();
+
+signals:
+    /* Ring went non‑empty since the last ackTicksReady(). */
+    void ticksReady();
+
+private slots:
+    void onFrame(const QString &frame);
+    void onSocketDisconnected();
+
+private:
+    bool ingest(const QString &frame, qint64 recvNs);
+    void startReplay();
+
+    const InstrumentTable &instruments;
+    TickRing              *ring;
+    std::atomic<bool>      drainPending {false};
+    QString                baseUrl;
+    int                    perConnection;
+    QList<QWebSocket*>     sockets;
+    QList<QUrl>            urls;          // parallel to sockets
+
+    QString                           capturePath;
+    QString                           replayPath;
+    double                            replaySpeed {1.0};
+    Capture::Writer                   capture;
+    std::unique_ptr<Capture::Replayer> replayer;
+};
+
+#endif // MARKETDATAFEED_H
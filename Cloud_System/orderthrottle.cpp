@@ -0,0 +1,128 @@
+/* =========================================================================
+   OrderThrottle.cpp – implementation of OrderThrottle.h
+   -------------------------------------------------------------------------
+   Lazy token‑bucket refill, bounded per‑user parking and round‑robin
+   release.
+   ========================================================================= */
+
+#include "orderthrottle.h"
+
+#include <QtGlobal>
+
+namespace {
+double envDouble(const char *name, double fallback){
+    bool ok = false;
+    const double v = qEnvironmentVariable(name).toDouble(&ok);
+    return ok ? v : fallback;
+}
+}
+
+OrderThrottle::Limits OrderThrottle::Limits::fromEnvironment(){
+    Limits l;
+    l.userRate    = envDouble("ORDER_RATE_PER_USER",  l.userRate);
+    l.userBurst   = envDouble("ORDER_BURST_PER_USER", l.userBurst);
+    l.globalRate  = envDouble("ORDER_RATE_GLOBAL",    l.globalRate);
+    l.globalBurst = envDouble("ORDER_BURST_GLOBAL",   l.globalBurst);
+    bool ok = false;
+    const int q = qEnvironmentVariableIntValue("ORDER_QUEUE_PER_USER", &ok);
+    if (ok) l.userQueue = qMax(0, q);
+    return l;
+}
+
+OrderThrottle::OrderThrottle(const Limits &l)
+    : limits(l)
+{
+    global.rate   = l.globalRate;
+    global.burst  = qMax(1.0, l.globalBurst);
+    global.tokens = global.burst;
+}
+
+void OrderThrottle::Bucket::refill(qint64 now){
+    if (rate <= 0.0) return;
+    if (last >= 0 && now > last)
+        tokens = qMin(burst, tokens + rate * double(now - last) * 1e-9);
+    last = now;
+}
+
+OrderThrottle::UserState &OrderThrottle::user(int uid){
+    auto it = users.find(uid);
+    if (it != users.end()) return it.value();
+
+    UserState s;
+    s.bucket.rate   = limits.userRate;
+    s.bucket.burst  = qMax(1.0, limits.userBurst);
+    s.bucket.tokens = s.bucket.burst;
+    return users.insert(uid, std::move(s)).value();
+}
+
+int OrderThrottle::queued(int uid) const{
+    auto it = users.constFind(uid);
+    return it == users.cend() ? 0 : int(it.value().pending.size());
+}
+
+quint64 OrderThrottle::rejected(int uid) const{
+    auto it = users.constFind(uid);
+    return it == users.cend() ? 0 : it.value().rejected;
+}
+
+/* ------------------------------------------------------------------------
+   Admit if both buckets have a token and nothing is parked ahead of it;
+   otherwise park, or reject once the user's queue is full.
+   ------------------------------------------------------------------------ */
+OrderThrottle::Outcome OrderThrottle::submit(const Wire::NewTrade &m, qint64 now){
+    UserState &u = user(m.userID);
+    u.bucket.refill(now);
+    global.refill(now);
+
+    if (u.pending.empty() && u.bucket.ready() && global.ready()) {
+        u.bucket.take();
+        global.take();
+        ++stat.admitted;
+        return Admitted;
+    }
+
+    if (int(u.pending.size()) >= limits.userQueue) {
+        ++u.rejected;
+        ++stat.rejected;
+        return Rejected;
+    }
+
+    if (u.pending.empty()) rotation.push_back(m.userID);
+    u.pending.push_back(m);
+    ++stat.queued;
+    ++stat.pending;
+    return Queued;
+}
+
+/* ------------------------------------------------------------------------
+   One order per user per pass; stops when the global bucket is dry or a
+   full pass over the rotation finds no user with a token.
+   ------------------------------------------------------------------------ */
+QList<Wire::NewTrade> OrderThrottle::release(qint64 now){
+    QList<Wire::NewTrade> out;
+    global.refill(now);
+
+    std::size_t idle = 0;
+    while (!rotation.empty() && global.ready() && idle < rotation.size()) {
+        const int uid = rotation.front();
+        rotation.pop_front();
+
+        UserState &u = users[uid];
+        u.bucket.refill(now);
+        if (!u.bucket.ready()) {
+            rotation.push_back(uid);
+            ++idle;
+            continue;
+        }
+        idle = 0;
+
+        u.bucket.take();
+        global.take();
+        out.append(std::move(u.pending.front()));
+        u.pending.pop_front();
+        --stat.pending;
+        ++stat.admitted;
+        if (!u.pending.empty()) rotation.push_back(uid);
+    }
+    return out;
+}
@@ -0,0 +1,102 @@
+/* =========================================================================
+   OrderThrottle.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Back‑pressure for order intake on the trade socket.
+
+   Key features
+   • Two token buckets gate every newTrade: one per user and one shared by
+     the whole server. An order is admitted only if both have a token.
+   • An order that finds no token is parked in its user's FIFO queue
+     (bounded by userQueue); past that it is rejected outright.
+   • release() hands parked orders back out round‑robin across users –
+     one order per user per pass – so a flooding script only ever delays
+     itself, never the people queued behind it.
+   • Per‑user queued / rejected counts feed the "throttle" report sent to
+     the dashboard; global admitted / queued / rejected go to the stats
+     log.
+
+   Design notes
+   • Limits come from the environment: $ORDER_RATE_PER_USER /
+     $ORDER_BURST_PER_USER and $ORDER_RATE_GLOBAL / $ORDER_BURST_GLOBAL
+     (orders / s, bucket depth), $ORDER_QUEUE_PER_USER (parked orders).
+     A rate ≤ 0 disables that bucket.
+   • Buckets refill lazily from a caller‑supplied monotonic clock, so the
+     class has no timer of its own and stays trivially testable.
+   • While a user has parked orders, new ones queue behind them even if
+     a token has come back – per‑user order is preserved.
+   • Lives on TradeServer's thread; not thread‑safe.
+   ========================================================================= */
+
+#ifndef ORDERTHROTTLE_H
+#define ORDERTHROTTLE_H
+
+#include "wireprotocol.h"
+
+#include <QHash>
+#include <QList>
+
+#include <deque>
+
+class OrderThrottle
+{
+public:
+    struct Limits {
+        double userRate    = 100.0;     // orders / s
+        double userBurst   = 20.0;
+        double globalRate  = 5000.0;
+        double globalBurst = 1000.0;
+        int    userQueue   = 50;
+
+        static Limits fromEnvironment();
+    };
+
+    enum Outcome { Admitted, Queued, Rejected };
+
+    struct Stats {
+        quint64 admitted = 0;
+        quint64 queued   = 0;
+        quint64 rejected = 0;
+        int     pending  = 0;
+    };
+
+    explicit OrderThrottle(const Limits &limits = Limits::fromEnvironment());
+
+    /* @p nowNs from a monotonic clock (QElapsedTimer::nsecsElapsed). */
+    Outcome submit(const Wire::NewTrade &order, qint64 nowNs);
+
+    /* Parked orders whose tokens are now available, fair across users. */
+    QList<Wire::NewTrade> release(qint64 nowNs);
+
+    bool    hasPending()          const { return stat.pending > 0; }
+    int     queued  (int userID)  const;
+    quint64 rejected(int userID)  const;
+    Stats   stats()               const { return stat; }
+
+private:
+    struct Bucket {
+        double rate   = 0.0;
+        double burst  = 0.0;
+        double tokens = 0.0;
+        qint64 last   = -1;
+
+        void refill(qint64 nowNs);
+        bool ready() const { return rate <= 0.0 || tokens >= 1.0; }
+        void take()        { if (rate > 0.0) tokens -= 1.0; }
+    };
+
+    struct UserState {
+        Bucket                      bucket;
+        std::deque<Wire::NewTrade>  pending;
+        quint64                     rejected = 0;
+    };
+
+    UserState &user(int userID);
+
+    Limits                  limits;
+    Bucket                  global;
+    QHash<int, UserState>   users;
+    std::deque<int>         rotation;    // users with parked orders
+    Stats                   stat;
+};
+
+#endif // ORDERTHROTTLE_H
@@ -0,0 +1,62 @@
+/* =========================================================================
+   PositionStore.cpp – implementation of PositionStore.h
+   -------------------------------------------------------------------------
+   Dense per‑asset columns + the single‑pass mark‑to‑market loop.
+   ========================================================================= */
+
+#include "positionstore.h"
+
+void PositionStore::add(Trade *t, double px){
+    const double side = t->isLong() ? 1.0 : -1.0;
+
+    slotOf.insert(t, static_cast<int>(trades.size()));
+    sides.push_back(side);
+    sizes.push_back(t->getSize());
+    openPrices.push_back(t->getOpenPrice());
+    pnls.push_back(side * (px - t->getOpenPrice()) * t->getSize());
+    trades.push_back(t);
+}
+
+/* Swap‑with‑last keeps every column dense ----------------------------- */
+void PositionStore::remove(Trade *t){
+    auto it = slotOf.find(t);
+    if (it == slotOf.end()) return;
+
+    const int slot = it.value();
+    const int last = static_cast<int>(trades.size()) - 1;
+    slotOf.erase(it);
+
+    if (slot != last) {
+        sides[slot]      = sides[last];
+        sizes[slot]      = sizes[last];
+        openPrices[slot] = openPrices[last];
+        pnls[slot]       = pnls[last];
+        trades[slot]     = trades[last];
+        slotOf[trades[slot]] = slot;
+    }
+    sides.pop_back();
+    sizes.pop_back();
+    openPrices.pop_back();
+    pnls.pop_back();
+    trades.pop_back();
+}
+
+/* ------------------------------------------------------------------------
+   Hot loop – restrict‑qualified raw pointers tell the compiler the columns
+   never alias, so the body vectorises cleanly at -O2/-O3.
+   ------------------------------------------------------------------------ */
+void PositionStore::markToMarket(double px){
+    const std::size_t n = pnls.size();
+    const double *__restrict side = sides.data();
+    const double *__restrict qty  = sizes.data();
+    const double *__restrict open = openPrices.data();
+    double       *__restrict out  = pnls.data();
+
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = side[i] * (px - open[i]) * qty[i];
+}
+
+double PositionStore::pnl(Trade *t) const{
+    auto it = slotOf.constFind(t);
+    return it == slotOf.cend() ? 0.0 : pnls[it.value()];
+}
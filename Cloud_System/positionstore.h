@@ -0,0 +1,57 @@
+/* =========================================================================
+   PositionStore.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Column‑oriented store of every open position in one asset.
+
+   Key features
+   • Struct‑of‑arrays layout: side, size, openPrice and pnl each live in
+     their own contiguous std::vector<double>.
+   • markToMarket(px) rewrites the whole pnl column in a single branch‑free
+     loop the compiler can vectorise – no Trade* chasing, no QString
+     compares on the tick path.
+   • O(1) add / remove / pnl lookup through a Trade* → slot index.
+
+   Design notes
+   • side is stored as +1.0 / −1.0 (read once from Trade::isLong()
+     at insert) so the loop body is pure arithmetic.
+   • remove() swaps the last slot into the hole, keeping the columns dense;
+     slot numbers are therefore not stable and never leave this class.
+   • Trade objects stay owned by EngineShard; the store keeps a back‑pointer
+     per slot only to re‑index the slot that moves on remove().
+   ========================================================================= */
+
+#ifndef POSITIONSTORE_H
+#define POSITIONSTORE_H
+
+#include "trade.h"
+
+#include <QHash>
+#include <vector>
+
+class PositionStore
+{
+public:
+    /* Append @p trade marked at @p px. */
+    void add(Trade *trade, double px);
+
+    /* Drop @p trade; no‑op if unknown. */
+    void remove(Trade *trade);
+
+    /* Recompute unrealised PnL of every position at price @p px. */
+    void markToMarket(double px);
+
+    /* Last marked PnL of @p trade (0 if unknown). */
+    double pnl(Trade *trade) const;
+
+    int size() const { return static_cast<int>(trades.size()); }
+
+private:
+    std::vector<double> sides;        // +1 long, −1 short
+    std::vector<double> sizes;
+    std::vector<double> openPrices;
+    std::vector<double> pnls;
+    std::vector<Trade*> trades;       // slot → trade (back‑reference)
+    QHash<Trade*, int>  slotOf;       // trade → slot
+};
+
+#endif // POSITIONSTORE_H
@@ -0,0 +1,71 @@
+/* =========================================================================
+   RiskGate.cpp – implementation of RiskGate.h
+   -------------------------------------------------------------------------
+   Constant‑time pre‑trade rules and their dashboard‑facing reasons.
+   ========================================================================= */
+
+#include "riskgate.h"
+
+#include <QtGlobal>
+#include <cmath>
+
+RiskLimits RiskLimits::fromEnvironment(){
+    RiskLimits l;
+    bool ok = false;
+    int  v  = qEnvironmentVariableIntValue("RISK_MAX_POSITIONS", &ok);
+    if (ok) l.maxOpenPositions = v;
+    v = qEnvironmentVariableIntValue("RISK_MAX_PER_ASSET", &ok);
+    if (ok) l.maxPerAsset = v;
+    return l;
+}
+
+RiskVerdict RiskGate::check(const Wire::NewTrade &m, double px,
+                            const AccountRecord &acc, double unrealised,
+                            int openPositions, int assetPositions) const{
+    if (!acc.active)                              return RiskVerdict::AccountLocked;
+    if (!(px > 0.0))                              return RiskVerdict::NoPrice;
+    if (!(m.size > 0.0) || !std::isfinite(m.size)) return RiskVerdict::InvalidSize;
+
+    const bool   isLong = m.side == Wire::Side::Long;
+    const double sl     = m.stopLoss;
+    const double tp     = m.takeProfit;
+    if (isLong) {
+        if ((sl != 0.0 && sl >= px) || (tp != 0.0 && tp <= px))
+            return RiskVerdict::InvalidStops;
+    } else {
+        if ((sl != 0.0 && sl <= px) || (tp != 0.0 && tp >= px))
+            return RiskVerdict::InvalidStops;
+    }
+
+    const double notional = m.size * px;
+    const double equity   = acc.balance + unrealised;
+    if (notional > equity) return RiskVerdict::Notional;
+
+    const double loss = sl != 0.0 ? std::abs(px - sl) * m.size : notional;
+    if (loss > equity - acc.maxLoss) return RiskVerdict::MaxLoss;
+
+    if (limits.maxPerAsset > 0 && assetPositions >= limits.maxPerAsset)
+        return RiskVerdict::AssetLimit;
+    if (limits.maxOpenPositions > 0 && openPositions >= limits.maxOpenPositions)
+        return RiskVerdict::PositionLimit;
+
+    return RiskVerdict::Accepted;
+}
+
+QString RiskGate::reason(RiskVerdict v){
+    switch (v) {
+    case RiskVerdict::Accepted:       return QString();
+    case RiskVerdict::UnknownAccount: return QStringLiteral("unknown account");
+    case RiskVerdict::AccountLocked:  return QStringLiteral("account locked");
+    case RiskVerdict::NoPrice:        return QStringLiteral("no live price");
+    case RiskVerdict::InvalidSize:    return QStringLiteral("invalid size");
+    case RiskVerdict::InvalidStops:   return QStringLiteral("stop-loss / take-profit on wrong side");
+    case RiskVerdict::Notional:       return QStringLiteral("notional exceeds equity");
+    case RiskVerdict::MaxLoss:        return QStringLiteral("potential loss exceeds max loss");
+    case RiskVerdict::AssetLimit:     return QStringLiteral("too many positions in asset");
+    case RiskVerdict::PositionLimit:  return QStringLiteral("too many open positions");
+    case RiskVerdict::RateLimited:    return QStringLiteral("rate limited");
+    case RiskVerdict::WrongUser:      return QStringLiteral("order for another user");
+    }
+    return QStringLiteral("rejected");
+}
@@ -0,0 +1,69 @@
+/* =========================================================================
+   RiskGate.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Authoritative pre‑trade checks applied to every order at cloud intake.
+
+   Key features
+   • One check() per order, run on the owning EngineShard right before the
+     fill. Rules, first failure wins:
+       – account known and active (checked in TradeServer at intake)
+       – a live price exists for the asset, size is positive and finite
+       – SL / TP sit on the right side of the fill price (0 = unset)
+       – notional (size × fill) ≤ equity
+       – potential loss at SL ≤ equity − max_loss
+       – open positions in this asset < $RISK_MAX_PER_ASSET
+       – open positions overall     < $RISK_MAX_POSITIONS
+   • Every input is already in memory – the account row comes from
+     AccountLedger, equity and position counts from the shard's
+     ExposureBook – so the gate costs microseconds and no SQL.
+   • The outcome is a RiskVerdict (RiskVerdict.h); reason() gives the
+     text sent back to the dashboard in the "orderAck" reply.
+
+   Design notes
+   • Mirrors DisplayManager::inputTrade on the desktop, but the client
+     checks are now advisory: the server never fills an order the gate
+     rejects.
+   • Equity = ledger balance + the shard's unrealised PnL. The balance is
+     snapshotted on TradeServer's thread when the order arrives, so a
+     close still in flight can make it lag by one trade – never by more.
+   • An unset SL has no bounded loss on paper; the full notional is used
+     as the potential loss instead.
+   • Limits ≤ 0 disable that rule.
+   ========================================================================= */
+
+#ifndef RISKGATE_H
+#define RISKGATE_H
+
+#include "accountledger.h"
+#include "riskverdict.h"
+#include "wireprotocol.h"
+
+#include <QMetaType>
+#include <QString>
+
+struct RiskLimits {
+    int maxOpenPositions = 100;   // $RISK_MAX_POSITIONS
+    int maxPerAsset      = 25;    // $RISK_MAX_PER_ASSET
+
+    static RiskLimits fromEnvironment();
+};
+
+class RiskGate
+{
+public:
+    explicit RiskGate(const RiskLimits &limits = RiskLimits::fromEnvironment())
+        : limits(limits) {}
+
+    /* @p unrealised is the user's open PnL at live prices; the position
+       counts are taken before this order is added. */
+    RiskVerdict check(const Wire::NewTrade &order, double fillPrice,
+                      const AccountRecord &account, double unrealised,
+                      int openPositions, int assetPositions) const;
+
+    static QString reason(RiskVerdict verdict);
+
+private:
+    RiskLimits limits;
+};
+
+#endif // RISKGATE_H
@@ -0,0 +1,40 @@
+/* =========================================================================
+   RiskVerdict.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Outcome of the cloud's order intake, sent back in every orderAck – the
+   binary frame carries it as OrderAck::code, JSON as "code".
+
+   Key features
+   • One enum for the server and every tool that reads acks (the
+     Load_Generator counts RateLimited rejects), so nobody hard‑codes the
+     numbers.
+
+   Design notes
+   • Values are on the wire: append new ones at the end, never reorder.
+   • Header‑only and Qt‑core only – no ledger / SQL dependency, so tools
+     can include it without linking the engine. The texts live in
+     RiskGate::reason().
+   ========================================================================= */
+
+#ifndef RISKVERDICT_H
+#define RISKVERDICT_H
+
+#include <QMetaType>
+
+enum class RiskVerdict : quint8 {
+    Accepted = 0,
+    UnknownAccount,
+    AccountLocked,
+    NoPrice,
+    InvalidSize,
+    InvalidStops,
+    Notional,
+    MaxLoss,
+    AssetLimit,
+    PositionLimit,
+    RateLimited,                  // OrderThrottle queue full (TradeServer)
+    WrongUser,                    // body userID ≠ the socket's user (TradeServer)
+};
+Q_DECLARE_METATYPE(RiskVerdict)
+
+#endif // RISKVERDICT_H
@@ -0,0 +1,83 @@
+/* =========================================================================
+   SpscRing.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Bounded, lock‑free single‑producer / single‑consumer ring buffer.
+
+   Key features
+   • push() / pop() are wait‑free: one relaxed load of the local index,
+     one acquire load of the peer index, one release store.
+   • Never blocks and never allocates after construction – a full ring
+     rejects the push and bumps a drop counter instead.
+   • size(), dropped() and highWater() are safe to read from any thread
+     for monitoring.
+
+   Design notes
+   • Capacity must be a power of two so wrap‑around is a mask, not a
+     modulo. Indices are free‑running 64‑bit counters (no ABA in practice).
+   • head/tail sit on separate cache lines to avoid false sharing between
+     the producer and consumer cores.
+   • Exactly one thread may push and exactly one thread may pop; anything
+     else is a data race.
+   ========================================================================= */
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <QtGlobal>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+template <typename T, std::size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+public:
+    /* Producer side. @return false (and count a drop) if the ring is full. */
+    bool push(const T &item){
+        const quint64 t = tail.load(std::memory_order_relaxed);
+        const quint64 h = head.load(std::memory_order_acquire);
+        if (t - h >= Capacity) {
+            drops.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        slots[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+
+        const quint64 depth = t + 1 - h;
+        if (depth > peak.load(std::memory_order_relaxed))
+            peak.store(depth, std::memory_order_relaxed);
+        return true;
+    }
+
+    /* Consumer side. @return false if the ring is empty. */
+    bool pop(T &item){
+        const quint64 h = head.load(std::memory_order_relaxed);
+        const quint64 t = tail.load(std::memory_order_acquire);
+        if (h == t) return false;
+        item = slots[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* ---- monitoring (any thread, approximate) ------------------------- */
+    std::size_t size() const {
+        return static_cast<std::size_t>(tail.load(std::memory_order_acquire) -
+                                        head.load(std::memory_order_acquire));
+    }
+    static constexpr std::size_t capacity() { return Capacity; }
+    quint64 dropped()   const { return drops.load(std::memory_order_relaxed); }
+    quint64 highWater() const { return peak.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<quint64> head  {0};   // consumer‑owned
+    alignas(64) std::atomic<quint64> tail  {0};   // producer‑owned
+    alignas(64) std::atomic<quint64> drops {0};   // producer‑owned
+    std::atomic<quint64>             peak  {0};   // producer‑owned
+    alignas(64) std::array<T, Capacity> slots {};
+};
+
+#endif // SPSCRING_H
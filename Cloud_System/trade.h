@@ -4,23 +4,31 @@
    Immutable record of a single position (open or closed).
 
    Key fields
-   • tradeID – auto‑generated if not supplied; guarantees uniqueness for
-     DB keys and UI diff views.
+   • tradeID – 64‑bit TradeId assigned by the cloud when the order fills
+     (see TradeId.h); 0 on a client‑side order that is still in flight.
+     The decimal string form is only for display and the database.
    • stopLoss / takeProfit – expressed in price units; 0 means "unset".
    • size – positive = long, negative = short; absolute value is quantity.
    • asset – symbol, tick size, and exchange metadata (see Asset.h).
    • openPrice – fill price at entry.
-   • type – e.g., "market".
-   • position – lifecycle status: "OPEN", "CLOSED".
+   • type – order type, stored as a one‑byte OrderType ("market").
+   • position – side, stored as a one‑byte TradeSide ("long" / "short").
 
    Design notes
    • Simple POD‑style class: getters only, no mutating logic beyond
      setStopLoss(), setTakeProfit(), and setPosition(). Risk checks happen
      at a higher layer (TradeManager).
-   • tradeCounter provides deterministic IDs when backend‑generated; helps
-     with offline unit tests where no UUID service is available.
+   • IDs are minted by the engine (TradeIds::Generator, one per shard), so
+     both sides can key their hash maps on the same integer.
    • No timestamps here – persisted in TradeHistory table alongside this
      schema to keep the core object small.
+   • Compact and heap‑free: every field is inline (48 bytes), and the
+     QString getters build their result from a literal, so the hot paths
+     (PositionStore, TriggerBook, PnL) read side() / isLong() instead.
+   • Class‑level operator new / delete draw from a per‑thread SlabPool
+     (ObjectPool.h), so opening / closing a position never touches the
+     general heap once the pool is warm. $TRADE_POOL=off falls back to
+     the heap with the same counters; poolStats() reports both.
    • TODO (beta) – add limit and stop orders
    ========================================================================= */
 
@@ -29,16 +37,22 @@
 #define TRADE_H
 
 #include "asset.h"
+#include "objectpool.h"
+#include "tradeid.h"
 
 #include <QString>
-#include <QDateTime>
-
+#include <cstddef>
 
+enum class TradeSide : quint8 { Long = 0, Short = 1 };     // = Wire::Side
+enum class OrderType : quint8 { Market = 0 };
 
 class Trade
 {
 public:
-    Trade(QString tradeID, double stopLoss, double takeProfit, double size,
+    Trade(TradeId tradeID, double stopLoss, double takeProfit, double size,
+          Asset asset, double openPrice, OrderType type, TradeSide side);
+
+    Trade(TradeId tradeID, double stopLoss, double takeProfit, double size,
           Asset asset, double openPrice, QString type, QString position);
 
     Trade(double stopLoss, double takeProfit, double size,
@@ -46,7 +60,13 @@ public:
 
     ~Trade();
 
-    QString getTradeID() const;
+    /* Pooled storage – see ObjectPool.h. Free on the allocating thread. */
+    static void *operator new(std::size_t size);
+    static void  operator delete(void *p);
+    static SlabPool::Stats poolStats();
+
+    TradeId getTradeID() const;
+    QString getTradeIDString() const { return TradeIds::toString(tradeID); }
 
     double getStopLoss() const;
     void setStopLoss(double stopLoss);
@@ -60,23 +80,26 @@ public:
 
     double getOpenPrice() const;
 
-    QString getType() const;
+    QString   getType()   const;
+    OrderType orderType() const { return type; }
+
+    QString   getPosition() const;
+    void      setPosition(const QString &position);
+    TradeSide side()   const { return position; }
+    bool      isLong() const { return position == TradeSide::Long; }
 
-    QString getPosition() const;
-    void setPosition(const QString &position);
+    static TradeSide sideFromString(const QString &position);
+    static OrderType orderTypeFromString(const QString &type);
 
 private:
-    static int tradeCounter;
-    QString tradeID;
-    double stopLoss;
-    double takeProfit;
-    double size;
-    Asset asset;
-    double openPrice;
-    QString type;
-    QString position;
-
-    void generateTradeID();  // Example: "Trade_20250526104512345_7"
+    TradeId   tradeID {0};
+    double    stopLoss;
+    double    takeProfit;
+    double    size;
+    double    openPrice;
+    Asset     asset;
+    OrderType type;
+    TradeSide position;
 };
 
 #endif // TRADE_H
@@ -0,0 +1,45 @@
+/* =========================================================================
+   TradeEvent.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Value record for one position life‑cycle step (open or close).
+
+   Key features
+   • Produced by an EngineShard on its worker thread and delivered to
+     TradeServer over a queued signal – carries everything persistence and
+     the alpha model need, so no Trade* ever crosses a thread boundary.
+
+   Design notes
+   • Plain copyable struct registered with the meta‑type system
+     (Q_DECLARE_METATYPE + qRegisterMetaType in TradeServer's ctor).
+   • closePrice / pnl are meaningful for Closed events only.
+   • tradeID is the numeric TradeId; it becomes a string only when it is
+     bound into Trade_History.trade_id.
+   ========================================================================= */
+
+#ifndef TRADEEVENT_H
+#define TRADEEVENT_H
+
+#include "asset.h"
+#include "tradeid.h"
+
+#include <QDateTime>
+#include <QMetaType>
+#include <QString>
+
+struct TradeEvent {
+    enum Kind : quint8 { Opened, Closed };
+
+    Kind      kind       = Opened;
+    int       userID     = 0;
+    TradeId   tradeID    = 0;
+    Asset     asset      = BTCUSDT;
+    double    size       = 0.0;
+    double    openPrice  = 0.0;
+    double    closePrice = 0.0;
+    double    pnl        = 0.0;
+    QDateTime at;
+};
+
+Q_DECLARE_METATYPE(TradeEvent)
+
+#endif // TRADEEVENT_H
@@ -0,0 +1,81 @@
+/* =========================================================================
+   TradeId.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Compact 64‑bit trade identifiers, assigned by the cloud at fill time.
+
+   Key features
+   • Layout (most significant first):
+         [41 bits ms since EPOCH_MS][10 bits node][12 bits sequence]
+     so IDs sort by creation time, need no coordination between engine
+     shards (node = shard index) and fit a machine word – hash look‑ups
+     and compares instead of QString walks.
+   • 4096 IDs per millisecond per node; 41 bits of milliseconds last ~69
+     years from EPOCH_MS.
+   • toString() / fromString() give the decimal form used only for
+     display, JSON (numbers there are doubles and would lose bits) and the
+     Trade_History.trade_id column.
+
+   Design notes
+   • Generator::next() never goes backwards: if the wall clock steps back
+     or a millisecond's sequence is exhausted, it keeps counting on the
+     last timestamp it issued.
+   • 0 is never issued – it means "not assigned yet" on the client.
+   • A Generator is single‑threaded (one per EngineShard).
+   • Mirrored in Cloud_System/ and trading_system_qt/Common/services/ –
+     keep the two copies in sync.
+   ========================================================================= */
+
+#ifndef TRADEID_H
+#define TRADEID_H
+
+#include <QDateTime>
+#include <QString>
+#include <QtGlobal>
+
+using TradeId = quint64;
+
+namespace TradeIds {
+
+constexpr qint64 EPOCH_MS      = 1704067200000LL;   // 2024‑01‑01T00:00:00Z
+constexpr int    NODE_BITS     = 10;
+constexpr int    SEQUENCE_BITS = 12;
+constexpr int    MAX_NODE      = (1 << NODE_BITS) - 1;
+constexpr int    MAX_SEQUENCE  = (1 << SEQUENCE_BITS) - 1;
+
+inline QString toString(TradeId id)            { return QString::number(id); }
+inline TradeId fromString(const QString &text) { return text.toULongLong(); }
+
+inline int       node(TradeId id)      { return int((id >> SEQUENCE_BITS) & MAX_NODE); }
+inline QDateTime createdAt(TradeId id) {
+    return QDateTime::fromMSecsSinceEpoch(
+        qint64(id >> (NODE_BITS + SEQUENCE_BITS)) + EPOCH_MS);
+}
+
+class Generator
+{
+public:
+    explicit Generator(int node) : nodeBits(TradeId(node & MAX_NODE) << SEQUENCE_BITS) {}
+
+    TradeId next(){
+        qint64 ms = QDateTime::currentMSecsSinceEpoch() - EPOCH_MS;
+        if (ms <= lastMs) {
+            ms = lastMs;
+            if (++sequence > MAX_SEQUENCE) { ++ms; sequence = 0; }
+        } else {
+            sequence = 0;
+        }
+        lastMs = ms;
+        const TradeId id = (TradeId(ms) << (NODE_BITS + SEQUENCE_BITS))
+                           | nodeBits | TradeId(sequence);
+        return id ? id : next();
+    }
+
+private:
+    TradeId nodeBits;
+    qint64  lastMs   {-1};
+    int     sequence {0};
+};
+
+} // namespace TradeIds
+
+#endif // TRADEID_H
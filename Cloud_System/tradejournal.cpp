@@ -0,0 +1,498 @@
+/* =========================================================================
+   TradeJournal.cpp – implementation of TradeJournal.h
+   -------------------------------------------------------------------------
+   Two mmap'd append‑only segments + QSaveFile snapshots written off the
+   shard thread, and the recovery pass that merges them on start‑up.
+   ========================================================================= */
+
+#include "tradejournal.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QMutexLocker>
+#include <QPair>
+#include <QSaveFile>
+#include <QSet>
+#include <QtDebug>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char SEGMENT_MAGIC[4]  = { 'R', 'M', 'J', 'L' };
+const char SNAPSHOT_MAGIC[4] = { 'R', 'M', 'J', 'S' };
+
+} // namespace
+
+TradeJournal::TradeJournal(const QString &dir, int shardIndex)
+    : dir(dir),
+    shard(shardIndex)
+{
+    static_assert(sizeof(Record) == 64, "journal record must stay one slot");
+    static_assert(sizeof(Header) <= std::size_t(HEADER_BYTES), "header too big");
+
+    bool ok = false;
+    int  mb = qEnvironmentVariableIntValue("JOURNAL_SEGMENT_MB", &ok);
+    if (!ok || mb <= 0) mb = DEFAULT_SEGMENT_MB;
+    capacity = qint64(mb) * 1024 * 1024;
+}
+
+TradeJournal::~TradeJournal(){
+    sync();
+    commitSnapshot();                             // leave one generation behind
+    for (Segment &seg : segments)
+        if (seg.base) seg.file.unmap(seg.base);
+}
+
+QString TradeJournal::filePath(const QString &dir, int shard, const char *ext){
+    return QDir(dir).filePath(QString("journal-%1.%2").arg(shard).arg(ext));
+}
+
+/* ------------------------------------------------------------------------
+   Size and map both segments, then snapshot the recovered state (here, on
+   the shard thread – nothing trades yet) so the files left by the
+   previous run are superseded before the first append.
+   ------------------------------------------------------------------------ */
+bool TradeJournal::open(const QList<JournalPosition> &positions){
+    /* never reuse a generation still on disk, whatever the clock says */
+    generation = snapshotGeneration(filePath(dir, shard, "snap"));
+    for (int i = 0; i < 2; ++i)
+        generation = qMax(generation,
+                          segmentGeneration(filePath(dir, shard, segmentExt(i))));
+
+    for (int i = 0; i < 2; ++i)
+        if (!mapSegment(i)) return false;
+    mapped = true;
+    sync();                                     // headers on disk first
+
+    const quint64 next = qMax(generation + 1,
+                              quint64(QDateTime::currentMSecsSinceEpoch()));
+    if (!writeSnapshot(next, positions)) return false;
+    generation = next;
+    active     = 0;
+    snapshots.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool TradeJournal::mapSegment(int i){
+    Segment &seg = segments[i];
+    seg.file.setFileName(filePath(dir, shard, segmentExt(i)));
+    if (!seg.file.open(QIODevice::ReadWrite) || !seg.file.resize(capacity)) {
+        qWarning() << "[TradeJournal] cannot open" << seg.file.fileName()
+                   << seg.file.errorString() << "– journaling disabled";
+        return false;
+    }
+    seg.base = seg.file.map(0, capacity);
+    if (!seg.base) {
+        qWarning() << "[TradeJournal] cannot map" << seg.file.fileName()
+                   << seg.file.errorString() << "– journaling disabled";
+        seg.file.close();
+        return false;
+    }
+
+    Header h {};
+    std::memcpy(h.magic, SEGMENT_MAGIC, sizeof h.magic);
+    h.version    = VERSION;
+    h.shard      = quint32(shard);
+    h.recordSize = sizeof(Record);
+    std::memcpy(seg.base, &h, sizeof h);
+    seg.tail.store(HEADER_BYTES, std::memory_order_release);
+    seg.synced.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+/* ------------------------------ appends --------------------------------- */
+bool TradeJournal::opened(int uid, const Trade &t){
+    return append(toRecord(Open, position(uid, t)));
+}
+
+bool TradeJournal::closed(int uid, TradeId tid){
+    JournalPosition p;
+    p.userID  = uid;
+    p.tradeID = tid;
+    return append(toRecord(Close, p));
+}
+
+bool TradeJournal::amended(int uid, const Trade &t){
+    return append(toRecord(Amend, position(uid, t)));
+}
+
+/* One memcpy into the mapping; the tail is published for sync() after. */
+bool TradeJournal::append(Record r){
+    if (!mapped) return true;                   // journaling disabled
+
+    Segment &seg = segments[active];
+    const qint64 at = seg.tail.load(std::memory_order_relaxed);
+    if (at + qint64(sizeof r) > capacity) return false;
+
+    r.generation = generation;
+    r.checksum   = checksum(r);
+    std::memcpy(seg.base + at, &r, sizeof r);
+    seg.tail.store(at + qint64(sizeof r), std::memory_order_release);
+
+    appended.store(appended.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+    dirty = true;
+    return true;
+}
+
+/* ------------------------------------------------------------------------
+   Shard thread: start a new generation in the other segment and leave the
+   copy for the sync thread. With a snapshot already in flight the copy is
+   dropped (dirty stays set, the next request retries) – unless the
+   active segment is full, then the shard has to commit it itself.
+   ------------------------------------------------------------------------ */
+void TradeJournal::requestSnapshot(const QList<JournalPosition> &positions){
+    if (!mapped) return;
+    {
+        QMutexLocker lock(&pendingMutex);
+        if (!pending.inFlight) { switchSegment(positions); return; }
+    }
+
+    const Segment &seg = segments[active];
+    if (seg.tail.load(std::memory_order_relaxed) + qint64(sizeof(Record)) <= capacity)
+        return;
+
+    qWarning() << "[TradeJournal] segment full before the last snapshot was"
+                  " committed – shard" << shard << "writing it inline";
+    commitSnapshot();
+    QMutexLocker lock(&pendingMutex);
+    if (!pending.inFlight) switchSegment(positions);
+}
+
+/* pendingMutex held. The other segment was rewound by the last commit. */
+void TradeJournal::switchSegment(const QList<JournalPosition> &positions){
+    const quint64 next = qMax(generation + 1,
+                              quint64(QDateTime::currentMSecsSinceEpoch()));
+    pending.positions  = positions;
+    pending.generation = next;
+    pending.retired    = active;
+    pending.inFlight   = true;
+
+    generation = next;
+    active     = 1 - active;
+    dirty      = false;
+}
+
+/* ------------------------------------------------------------------------
+   Sync thread: the snapshot (fsync + atomic rename by QSaveFile) lands
+   before the retired segment is rewound – until then recovery still
+   needs its records.
+   ------------------------------------------------------------------------ */
+bool TradeJournal::commitSnapshot(){
+    QMutexLocker commit(&commitMutex);
+
+    Pending job;
+    {
+        QMutexLocker lock(&pendingMutex);
+        if (!pending.inFlight) return true;
+        job = pending;
+    }
+    if (!writeSnapshot(job.generation, job.positions)) return false;
+
+    rewind(job.retired);
+    {
+        QMutexLocker lock(&pendingMutex);
+        pending.positions.clear();
+        pending.inFlight = false;
+    }
+    snapshots.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool TradeJournal::writeSnapshot(quint64 gen, const QList<JournalPosition> &positions){
+    QSaveFile file(filePath(dir, shard, "snap"));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[TradeJournal] cannot write" << file.fileName()
+                   << file.errorString();
+        return false;
+    }
+    QDataStream out(&file);
+    out.writeRawData(SNAPSHOT_MAGIC, sizeof SNAPSHOT_MAGIC);
+    out << VERSION << quint32(shard) << gen << quint32(positions.size());
+    for (const JournalPosition &p : positions) {
+        Record r     = toRecord(Open, p);
+        r.generation = gen;
+        r.checksum   = checksum(r);
+        out.writeRawData(reinterpret_cast<const char*>(&r), sizeof r);
+    }
+    if (!file.commit()) {
+        qWarning() << "[TradeJournal] snapshot commit failed for"
+                   << file.fileName() << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void TradeJournal::rewind(int i){
+    QMutexLocker lock(&mapMutex);
+    segments[i].tail.store(HEADER_BYTES, std::memory_order_release);
+    segments[i].synced.store(HEADER_BYTES, std::memory_order_relaxed);
+}
+
+/* ------------------------------------------------------------------------
+   Sync thread: msync whatever was appended since the last call. Only the
+   pages between the last synced byte and the tail are written back.
+   ------------------------------------------------------------------------ */
+void TradeJournal::sync(){
+    QMutexLocker lock(&mapMutex);
+    if (!mapped) return;
+
+    for (Segment &seg : segments) {
+        const qint64 end  = seg.tail.load(std::memory_order_acquire);
+        const qint64 from = seg.synced.load(std::memory_order_relaxed);
+        if (end <= from) continue;
+
+#ifdef Q_OS_UNIX
+        const qint64 page  = qMax<qint64>(1, sysconf(_SC_PAGESIZE));
+        const qint64 start = from / page * page;
+        if (msync(seg.base + start, std::size_t(end - start), MS_SYNC) != 0) {
+            qWarning() << "[TradeJournal] msync failed for" << seg.file.fileName();
+            continue;
+        }
+#endif
+        seg.synced.store(end, std::memory_order_relaxed);
+        syncs.store(syncs.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+    }
+}
+
+TradeJournal::Stats TradeJournal::stats() const{
+    Stats s;
+    s.appended  = appended.load(std::memory_order_relaxed);
+    s.snapshots = snapshots.load(std::memory_order_relaxed);
+    s.syncs     = syncs.load(std::memory_order_relaxed);
+    s.usedBytes = qMax(segments[0].tail.load(std::memory_order_relaxed),
+                       segments[1].tail.load(std::memory_order_relaxed));
+    s.sizeBytes = capacity;
+    return s;
+}
+
+/* ------------------------------ records --------------------------------- */
+JournalPosition TradeJournal::position(int uid, const Trade &t){
+    JournalPosition p;
+    p.tradeID    = t.getTradeID();
+    p.userID     = uid;
+    p.asset      = t.getAsset();
+    p.side       = t.side();
+    p.type       = t.orderType();
+    p.size       = t.getSize();
+    p.stopLoss   = t.getStopLoss();
+    p.takeProfit = t.getTakeProfit();
+    p.openPrice  = t.getOpenPrice();
+    return p;
+}
+
+TradeJournal::Record TradeJournal::toRecord(Kind kind, const JournalPosition &p){
+    Record r {};
+    r.kind       = kind;
+    r.side       = static_cast<quint8>(p.side);
+    r.type       = static_cast<quint8>(p.type);
+    r.userID     = p.userID;
+    r.asset      = static_cast<qint32>(p.asset);
+    r.tradeID    = p.tradeID;
+    r.size       = p.size;
+    r.stopLoss   = p.stopLoss;
+    r.takeProfit = p.takeProfit;
+    r.openPrice  = p.openPrice;
+    return r;
+}
+
+JournalPosition TradeJournal::fromRecord(const Record &r){
+    JournalPosition p;
+    p.tradeID    = r.tradeID;
+    p.userID     = r.userID;
+    p.asset      = static_cast<Asset>(r.asset);
+    p.side       = static_cast<TradeSide>(r.side);
+    p.type       = static_cast<OrderType>(r.type);
+    p.size       = r.size;
+    p.stopLoss   = r.stopLoss;
+    p.takeProfit = r.takeProfit;
+    p.openPrice  = r.openPrice;
+    return p;
+}
+
+/* FNV‑1a over everything after the checksum field */
+quint32 TradeJournal::checksum(const Record &r){
+    const uchar *p = reinterpret_cast<const uchar*>(&r) + sizeof r.checksum;
+    quint32 h = 2166136261u;
+    for (std::size_t i = sizeof r.checksum; i < sizeof r; ++i, ++p) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* ------------------------------ recovery -------------------------------- */
+QList<JournalPosition> TradeJournal::recover(const QString &dir){
+    QSet<int> indexes;
+    const QStringList files = QDir(dir).entryList(
+        { "journal-*.snap", "journal-*.log", "journal-*.log1" }, QDir::Files);
+    for (const QString &f : files) {
+        bool ok = false;
+        const int i = f.section('.', 0, 0).section('-', 1).toInt(&ok);
+        if (ok) indexes.insert(i);
+    }
+
+    QHash<TradeId, JournalPosition> open;
+    for (int i : indexes) {
+        QHash<TradeId, JournalPosition> shardOpen;
+        quint64 gen  = 0;
+        const bool have = loadSnapshot(filePath(dir, i, "snap"), &gen, &shardOpen);
+
+        /* segments at or above the snapshot's generation, oldest first */
+        QList<QPair<quint64, QString>> segs;
+        for (int k = 0; k < 2; ++k) {
+            const QString path = filePath(dir, i, segmentExt(k));
+            const quint64 g    = segmentGeneration(path);
+            if (g != 0 && (!have || g >= gen)) segs << qMakePair(g, path);
+        }
+        std::sort(segs.begin(), segs.end());
+        for (const auto &seg : segs)
+            replaySegment(seg.second, seg.first, &shardOpen);
+        open.insert(shardOpen);
+    }
+
+    QList<JournalPosition> out = open.values();
+    std::sort(out.begin(), out.end(),
+              [](const JournalPosition &a, const JournalPosition &b) {
+                  return a.tradeID < b.tradeID;
+              });
+    return out;
+}
+
+quint64 TradeJournal::snapshotGeneration(const QString &path){
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return 0;
+    QDataStream in(&file);
+    char    magic[4];
+    quint32 version = 0, shard = 0;
+    quint64 gen = 0;
+    if (in.readRawData(magic, sizeof magic) != int(sizeof magic) ||
+        std::memcmp(magic, SNAPSHOT_MAGIC, sizeof magic) != 0)
+        return 0;
+    in >> version >> shard >> gen;
+    return in.status() == QDataStream::Ok ? gen : 0;
+}
+
+bool TradeJournal::loadSnapshot(const QString &path, quint64 *gen,
+                                QHash<TradeId, JournalPosition> *out){
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream in(&file);
+    char    magic[4];
+    quint32 version = 0, shard = 0, count = 0;
+    if (in.readRawData(magic, sizeof magic) != int(sizeof magic) ||
+        std::memcmp(magic, SNAPSHOT_MAGIC, sizeof magic) != 0) {
+        qWarning() << "[TradeJournal] not a snapshot:" << path;
+        return false;
+    }
+    in >> version >> shard >> *gen >> count;
+    if (in.status() != QDataStream::Ok || version != VERSION) {
+        qWarning() << "[TradeJournal] unsupported snapshot" << path
+                   << "version" << version;
+        return false;
+    }
+
+    for (quint32 n = 0; n < count; ++n) {
+        Record r;
+        if (in.readRawData(reinterpret_cast<char*>(&r), sizeof r) != int(sizeof r)) {
+            qWarning() << "[TradeJournal] truncated snapshot" << path
+                       << "– kept" << n << "of" << count << "positions";
+            break;
+        }
+        if (r.checksum != checksum(r) || r.kind != Open) continue;
+        out->insert(r.tradeID, fromRecord(r));
+    }
+    return true;
+}
+
+/* Generation of a segment's first valid record, 0 if there is none. */
+quint64 TradeJournal::segmentGeneration(const QString &path){
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) ||
+        file.size() < HEADER_BYTES + qint64(sizeof(Record)))
+        return 0;
+    Record r;
+    if (!file.seek(HEADER_BYTES) ||
+        file.read(reinterpret_cast<char*>(&r), sizeof r) != qint64(sizeof r))
+        return 0;
+    return (r.kind != Empty && r.checksum == checksum(r)) ? r.generation : 0;
+}
+
+void TradeJournal::replaySegment(const QString &path, quint64 gen,
+                                 QHash<TradeId, JournalPosition> *out){
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < HEADER_BYTES) return;
+
+    const qint64 size = file.size();
+    const uchar *map  = file.map(0, size);
+    if (!map) {
+        qWarning() << "[TradeJournal] cannot map" << path << file.errorString();
+        return;
+    }
+
+    Header h;
+    std::memcpy(&h, map, sizeof h);
+    if (std::memcmp(h.magic, SEGMENT_MAGIC, sizeof h.magic) != 0 ||
+        h.version != VERSION || h.recordSize != sizeof(Record)) {
+        qWarning() << "[TradeJournal] unsupported segment" << path;
+        return;
+    }
+
+    int applied = 0;
+    for (qint64 at = HEADER_BYTES; at + qint64(sizeof(Record)) <= size;
+         at += qint64(sizeof(Record))) {
+        Record r;
+        std::memcpy(&r, map + at, sizeof r);
+        if (r.kind == Empty) break;
+        if (r.checksum != checksum(r)) {
+            qWarning() << "[TradeJournal] torn record at" << at << "in" << path
+                       << "– ignoring the rest";
+            break;
+        }
+        if (r.generation != gen) break;         // stale tail of another generation
+
+        switch (r.kind) {
+        case Open:
+            out->insert(r.tradeID, fromRecord(r));
+            break;
+        case Close:
+            out->remove(r.tradeID);
+            break;
+        case Amend: {
+            auto it = out->find(r.tradeID);
+            if (it != out->end()) {
+                it->stopLoss   = r.stopLoss;
+                it->takeProfit = r.takeProfit;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        ++applied;
+    }
+    if (applied)
+        qDebug() << "[TradeJournal] replayed" << applied << "records from" << path;
+}
+
+void TradeJournal::removeStale(const QString &dir, int shardCount){
+    QDir d(dir);
+    const QStringList files = d.entryList({ "journal-*.snap", "journal-*.log",
+                                            "journal-*.log1" }, QDir::Files);
+    for (const QString &f : files) {
+        bool ok = false;
+        const int i = f.section('.', 0, 0).section('-', 1).toInt(&ok);
+        if (ok && i >= shardCount && d.remove(f))
+            qDebug() << "[TradeJournal] removed stale" << f;
+    }
+}
@@ -0,0 +1,211 @@
+/* =========================================================================
+   TradeJournal.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Crash‑safe record of one EngineShard's open positions: an append‑only,
+   memory‑mapped event journal plus periodic snapshots.
+
+   Key features
+   • Every fill, close and SL/TP amend is appended as one fixed‑size,
+     checksummed record into a pre‑sized mmap'd segment – a memcpy on the
+     shard thread, no syscall. Once copied, the record survives a crash of
+     the process (the page cache owns it).
+   • sync() flushes the written range to disk (msync) and is meant for a
+     background timer thread – fsyncs are batched every $JOURNAL_SYNC_MS
+     and never run on the tick path.
+   • Two segments (journal‑<shard>.log / .log1) take turns.
+     requestSnapshot() on the shard thread only takes the copy of the open
+     positions it is handed and flips appends to the other, already
+     rewound segment under a new generation – no file I/O. The sync
+     thread's commitSnapshot() writes journal‑<shard>.snap (QSaveFile:
+     temp file, fsync, atomic rename) and then rewinds the retired
+     segment. Requested every $JOURNAL_SNAPSHOT_S and whenever a segment
+     ($JOURNAL_SEGMENT_MB) fills up.
+   • recover(dir) rebuilds the open positions of every shard's files –
+     snapshot first, then the journal tail – without touching Postgres.
+
+   Design notes
+   • Every record carries the generation of the snapshot it follows, and
+     replay stops at the first record of another generation – emptying
+     a segment is just rewinding the tail. Recovery replays the segments
+     whose generation is at least the snapshot's, oldest first: while a
+     snapshot is still being written that is the old generation and then
+     the new one on top, afterwards only the new one. open() starts
+     above any generation already on disk, so a clock step cannot reuse
+     one.
+   • Records are idempotent per TradeId (open = insert, close = remove,
+     amend = overwrite), so a snapshot taken from a copy that already
+     contains some of the new segment's records replays correctly.
+   • At most one snapshot is in flight. If the active segment fills
+     before the sync thread has committed it, the shard commits it
+     itself – the only path on which a shard waits on the disk, and only
+     after a full segment's worth of events inside one sync period.
+   • Replay also stops at an empty slot or a bad checksum (a torn write at
+     the tail). Records are host‑endian – the files never leave the box.
+   • Files are keyed by shard index but recover() returns plain records;
+     TradeServer re‑routes them by userID, so $ENGINE_SHARDS may change
+     between runs (removeStale() drops files of shards that are gone).
+   • Appends and requestSnapshot() run on the owning shard's thread,
+     sync() / commitSnapshot() on the sync thread. mapMutex fences sync()
+     against a segment being rewound, pendingMutex guards the in‑flight
+     snapshot and commitMutex serialises the two possible committers.
+   • Restored trades keep their TradeIds; the shard generators are time
+     based, so new IDs stay above them.
+   ========================================================================= */
+
+#ifndef TRADEJOURNAL_H
+#define TRADEJOURNAL_H
+
+#include "trade.h"
+
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+#include <atomic>
+
+/* One open position as journaled – a Trade without the object. */
+struct JournalPosition {
+    TradeId   tradeID    = 0;
+    int       userID     = 0;
+    Asset     asset      = BTCUSDT;
+    TradeSide side       = TradeSide::Long;
+    OrderType type       = OrderType::Market;
+    double    size       = 0.0;
+    double    stopLoss   = 0.0;
+    double    takeProfit = 0.0;
+    double    openPrice  = 0.0;
+};
+
+class TradeJournal
+{
+public:
+    static constexpr int DEFAULT_SEGMENT_MB  = 64;
+    static constexpr int DEFAULT_SYNC_MS     = 20;
+    static constexpr int DEFAULT_SNAPSHOT_S  = 60;
+
+    struct Stats {
+        quint64 appended   = 0;
+        quint64 snapshots  = 0;
+        quint64 syncs      = 0;
+        qint64  usedBytes  = 0;
+        qint64  sizeBytes  = 0;
+    };
+
+    TradeJournal(const QString &dir, int shardIndex);
+    ~TradeJournal();
+
+    TradeJournal(const TradeJournal&)            = delete;
+    TradeJournal& operator=(const TradeJournal&) = delete;
+
+    /* ---- owning shard's thread ----------------------------------------- */
+    /* Map the segment and write the first snapshot of @p positions. */
+    bool open(const QList<JournalPosition> &positions);
+    bool isOpen() const { return mapped; }
+
+    /* false = segment full, nothing written: requestSnapshot() of the
+       current state (which already includes the event) instead. */
+    bool opened (int userID, const Trade &trade);
+    bool closed (int userID, TradeId tradeID);
+    bool amended(int userID, const Trade &trade);
+
+    /* Hand over a copy of every open position and switch segments; the
+       snapshot itself is written by commitSnapshot(). */
+    void requestSnapshot(const QList<JournalPosition> &positions);
+    bool needsSnapshot() const { return dirty; }
+
+    /* ---- sync thread (any thread) ---------------------------------------- */
+    void  sync();
+    /* Write the in‑flight snapshot, if any, and rewind the retired segment. */
+    bool  commitSnapshot();
+    Stats stats() const;
+
+    /* Open positions left by a previous run, all shards' files merged. */
+    static QList<JournalPosition> recover(const QString &dir);
+    /* Delete the files of shard indexes >= @p shardCount. */
+    static void removeStale(const QString &dir, int shardCount);
+
+    static JournalPosition position(int userID, const Trade &trade);
+
+private:
+    enum Kind : quint8 { Empty = 0, Open = 1, Close = 2, Amend = 3 };
+
+    /* 64 bytes, fixed – one slot per event, also the snapshot row format */
+    struct Record {
+        quint32 checksum;
+        quint8  kind;
+        quint8  side;
+        quint8  type;
+        quint8  reserved;
+        qint32  userID;
+        qint32  asset;
+        quint64 generation;
+        quint64 tradeID;
+        double  size;
+        double  stopLoss;
+        double  takeProfit;
+        double  openPrice;
+    };
+
+    struct Header {
+        char    magic[4];
+        quint32 version;
+        quint32 shard;
+        quint32 recordSize;
+    };
+
+    static constexpr quint32 VERSION      = 1;
+    static constexpr qint64  HEADER_BYTES = 64;   // records start here
+
+    struct Segment {
+        QFile                file;
+        uchar               *base   {nullptr};
+        std::atomic<qint64>  tail   {0};   // bytes written (incl. header)
+        std::atomic<qint64>  synced {0};   // bytes known to be on disk
+    };
+
+    struct Pending {
+        QList<JournalPosition> positions;
+        quint64                generation {0};
+        int                    retired    {-1};   // segment to rewind after commit
+        bool                   inFlight   {false};
+    };
+
+    bool append(Record r);
+    bool mapSegment(int i);
+    void switchSegment(const QList<JournalPosition> &positions);
+    void rewind(int i);
+    bool writeSnapshot(quint64 generation, const QList<JournalPosition> &positions);
+    static QString filePath(const QString &dir, int shard, const char *ext);
+    static const char *segmentExt(int i) { return i == 0 ? "log" : "log1"; }
+    static quint64 segmentGeneration(const QString &path);
+
+    static Record          toRecord(Kind kind, const JournalPosition &p);
+    static JournalPosition fromRecord(const Record &r);
+    static quint32         checksum(const Record &r);
+    static quint64         snapshotGeneration(const QString &path);
+    static bool            loadSnapshot(const QString &path, quint64 *generation,
+                                        QHash<TradeId, JournalPosition> *out);
+    static void            replaySegment(const QString &path, quint64 generation,
+                                         QHash<TradeId, JournalPosition> *out);
+
+    QString   dir;
+    int       shard;
+    Segment   segments[2];
+    int       active     {0};             // shard thread only
+    qint64    capacity   {0};
+    quint64   generation {0};             // of the active segment
+    bool      dirty      {false};
+    bool      mapped     {false};
+
+    QMutex                 mapMutex;      // sync() vs rewind()
+    QMutex                 pendingMutex;  // pending
+    QMutex                 commitMutex;   // one commitSnapshot() at a time
+    Pending                pending;
+    std::atomic<quint64>   appended  {0};
+    std::atomic<quint64>   snapshots {0};
+    std::atomic<quint64>   syncs     {0};
+};
+
+#endif // TRADEJOURNAL_H
@@ -4,12 +4,15 @@
    Bridges trader dashboards, live Binance price feeds, and the cloud-side
    risk engine.
 
-     • Manages GUI WebSocket sessions and maps each socket to a user-ID.
-     • Opens four outbound Binance 1-minute k-line feeds (BTC, ETH, SOL, XRP).
-     • Keeps a per-user Trade* → PnL map and emits equityUpdate so
-       AccountServer can enforce draw-down limits.
-     • Handles stop-loss / take-profit hits automatically or via “closeTrade”.
-     • Streams realised trades + benchmark returns into AlphaCalculator.
+     • Manages GUI WebSocket sessions and maps each socket to a user-ID;
+       each socket speaks compact JSON or the binary WireProtocol.
+     • Streams 1-minute k-lines for every configured symbol through one
+       MarketDataFeed (combined Binance streams, N symbols per socket).
+     • Partitions users across EngineShards; every tick is broadcast to
+       all shards, orders / closes go to the shard owning the user.
+     • Queues shard TradeEvents for write-behind persistence, relays equityUpdate / tradeClosed to
+       AccountServer and streams realised trades + daily benchmark returns
+       into the AnalyticsEngine thread.
    ========================================================================= */
 
 #include "tradeserver.h"
@@ -21,6 +24,9 @@
 #include <QJsonObject>
 #include <QSqlError>
 #include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QStandardPaths>
 #include <QtDebug>
 
 /* -------------------------------------------------------------------------
@@ -29,9 +35,13 @@
 TradeServer::TradeServer(quint16 port, QObject *parent)
     : QObject(parent),
     server(new QWebSocketServer(QStringLiteral("Trade WebSocket Server"),
-                                QWebSocketServer::NonSecureMode, this)),
-    db(DatabaseManager::getInstance().getDatabase())
+                                QWebSocketServer::NonSecureMode, this))
 {
+    qRegisterMetaType<TradeEvent>();
+    qRegisterMetaType<RiskVerdict>();
+
+    initializeAnalytics();
+
     if (server->listen(QHostAddress::Any, port)) {
         qDebug() << "[TradeServer] listening on port" << port;
         connect(server, &QWebSocketServer::newConnection,
@@ -40,28 +50,14 @@ TradeServer::TradeServer(quint16 port, QObject *parent)
         qFatal("[TradeServer] cannot listen – port busy?");
     }
 
-    /* Pass through alpha updates to dashboards (if user online) */
-    connect(&alphaCalc, &AlphaCalculator::alphaUpdated,
-            this, [this](int uid, double alpha)
-            {
-                QSqlQuery q(db);
-                q.prepare("UPDATE \"Account\" SET alpha=:a WHERE user_id=:u");
-                q.bindValue(":a", alpha);
-                q.bindValue(":u", uid);
-                if (!q.exec())
-                    qWarning() << q.lastError();
-
-                if (accountServer &&
-                    accountServer->getUserSessions().contains(uid)) {
-                    QJsonObject obj;  obj["type"] = "alphaUpdated";
-                    const QString msg =
-                        QJsonDocument(obj).toJson(QJsonDocument::Compact);
-                    for (QWebSocket *s : accountServer->getUserSessions()[uid])
-                        if (s) s->sendTextMessage(msg);
-                }
-            });
+    intakeClock.start();
+    connect(&throttleTimer, &QTimer::timeout,
+            this,           &TradeServer::drainThrottle);
 
-    initializeAssetWebSockets();
+    dataDir = persistentDirectory();
+    initializePersistence();
+    initializeEngine();
+    initializeMarketData();
 }
 
 void TradeServer::setAccountServer(AccountServer *acc){
@@ -71,28 +67,293 @@ void TradeServer::setAccountServer(AccountServer *acc){
 }
 
 /* -------------------------------------------------------------------------
-   Open four Binance price streams (1-min klines) and hook their tick slots
+   One AnalyticsEngine on its own thread / connection. Cold start: the last
+   BUCKET_WINDOW days of closed trades for every user are loaded in one
+   parallel pass before listen(), so no dashboard ever sees a half‑built
+   window. Alpha goes through AccountServer's ledger (persist) and out to
+   dashboards (if user online).
+   ------------------------------------------------------------------------- */
+void TradeServer::initializeAnalytics(){
+    analytics = new AnalyticsEngine;
+    if (!analytics->warmUp(QDate::currentDate()))
+        qWarning() << "[TradeServer] alpha warm‑up failed – starting cold";
+
+    analytics->moveToThread(&analyticsThread);
+    analyticsThread.setObjectName("analytics");
+    connect(&analyticsThread, &QThread::started,
+            analytics,        &AnalyticsEngine::start);
+    connect(&analyticsThread, &QThread::finished,
+            analytics,        &QObject::deleteLater);
+    connect(analytics, &AnalyticsEngine::alphaUpdated,
+            this, [this](int uid, double alpha)
+            {
+                if (accountServer)
+                    accountServer->pushAlpha(uid, alpha);
+            });
+    analyticsThread.start();
+}
+
+/* -------------------------------------------------------------------------
+   Where the journal and the TradeWriter spill live: $JOURNAL_DIR, else
+   trade_journal under the per‑user application data directory. Never the
+   temp dir – both hold state that is nowhere else yet (open positions,
+   un‑persisted Trade_History rows), and a reboot that clears /tmp would
+   lose it, so without a persistent location the cloud does not start.
+   ------------------------------------------------------------------------- */
+static QString persistentDirectory(){
+    QString dir = qEnvironmentVariable("JOURNAL_DIR");
+    if (dir.isEmpty()) {
+        const QString appData =
+            QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+        if (!appData.isEmpty()) dir = QDir(appData).filePath("trade_journal");
+    }
+    if (dir.isEmpty() || !QDir().mkpath(dir))
+        qFatal("[TradeServer] no usable journal directory – set $JOURNAL_DIR");
+    qDebug() << "[TradeServer] journal directory" << dir;
+    return dir;
+}
+
+/* -------------------------------------------------------------------------
+   Write‑behind Trade_History persistence on its own thread / connection;
+   the overflow file sits next to the journal unless $TRADE_WRITER_SPILL
+   names another one.
    ------------------------------------------------------------------------- */
-void TradeServer::initializeAssetWebSockets(){
-    const QString base = "wss://stream.binance.com:9443/ws/";
-    const QStringList ep = {
-        "btcusdt@kline_1m", "ethusdt@kline_1m",
-        "solusdt@kline_1m", "xrpusdt@kline_1m"
-    };
-
-    for (const QString &e : ep) {
-        QWebSocket *ws = new QWebSocket;
-        ws->open(QUrl(base + e));
-        assetWebSockets << ws;
+void TradeServer::initializePersistence(){
+    const QString spillPath = qEnvironmentVariable(
+        "TRADE_WRITER_SPILL", QDir(dataDir).filePath("trade_history.spill"));
+
+    tradeWriter = new TradeWriter(spillPath);
+    tradeWriter->moveToThread(&writerThread);
+    writerThread.setObjectName("trade-writer");
+    connect(&writerThread, &QThread::started,
+            tradeWriter,   &TradeWriter::start);
+    connect(&writerThread, &QThread::finished,
+            tradeWriter,   &QObject::deleteLater);
+    writerThread.start();
+}
+
+/* -------------------------------------------------------------------------
+   $ENGINE_SHARDS worker threads (0 / unset → one shard on this thread);
+   $ENGINE_PIN_CPUS=1 pins shard i to CPU (i + 1) mod cores, leaving CPU 0
+   for the socket / market‑data side.
+   Open positions are recovered from the journal directory (see
+   persistentDirectory()) before the first order:
+   every shard restores its users' positions (re‑routed by userID, so the
+   shard count may change between runs) and re‑snapshots its journal.
+   ------------------------------------------------------------------------- */
+void TradeServer::initializeEngine(){
+    const int  threads = qMax(0, qEnvironmentVariableIntValue("ENGINE_SHARDS"));
+    const bool pin     = qEnvironmentVariableIntValue("ENGINE_PIN_CPUS") != 0;
+    const int  cores   = qMax(1, QThread::idealThreadCount());
+
+    const QString &journalDir = dataDir;
+    QElapsedTimer recoveryClock;
+    recoveryClock.start();
+    const QList<JournalPosition> recovered = TradeJournal::recover(journalDir);
+
+    if (threads == 0) {
+        shards << new EngineShard(0, journalDir, this);
+    } else {
+        for (int i = 0; i < threads; ++i) {
+            EngineShard *shard = new EngineShard(i, journalDir);
+            QThread     *th    = new QThread(this);
+            th->setObjectName(QString("engine-shard-%1").arg(i));
+            shard->moveToThread(th);
+            connect(th, &QThread::finished, shard, &QObject::deleteLater);
+            th->start();
+
+            if (pin) {
+                const int cpu = (i + 1) % cores;
+                QMetaObject::invokeMethod(shard, [shard, cpu]() {
+                    shard->pinToCpu(cpu);
+                }, Qt::QueuedConnection);
+            }
+            shards       << shard;
+            shardThreads << th;
+        }
+    }
+
+    for (EngineShard *shard : shards) {
+        connect(shard, &EngineShard::equityUpdate,
+                this,  &TradeServer::equityUpdate);
+        connect(shard, &EngineShard::tradeEvent,
+                this,  &TradeServer::onTradeEvent);
+        connect(shard, &EngineShard::orderAck,
+                this,  &TradeServer::onOrderAck);
+        connect(shard, &EngineShard::dashboardPush,
+                this,  &TradeServer::sendToUser);
+    }
+    qDebug() << "[TradeServer] engine running" << shards.size() << "shard(s)"
+             << (threads ? "on worker threads" : "inline")
+             << (pin && threads ? "(pinned)" : "");
+
+    /* Restore before any order can be routed; block so the stale files
+       are only dropped once every shard has re-snapshotted. */
+    QList<QList<JournalPosition>> perShard(shards.size());
+    for (const JournalPosition &p : recovered)
+        perShard[int(uint(p.userID) % uint(shards.size()))] << p;
+    for (EngineShard *shard : shards) {
+        const QList<JournalPosition> mine = perShard[shard->index()];
+        QMetaObject::invokeMethod(shard, [shard, mine]() {
+            shard->restore(mine);
+        }, threads ? Qt::BlockingQueuedConnection : Qt::DirectConnection);
+    }
+    TradeJournal::removeStale(journalDir, shards.size());
+    qDebug() << "[TradeServer] recovered" << recovered.size()
+             << "open position(s) from" << journalDir << "in"
+             << recoveryClock.elapsed() << "ms";
+
+    initializeJournalSync();
+}
+
+/* -------------------------------------------------------------------------
+   Batched durability: one background thread msyncs every shard's journal
+   every $JOURNAL_SYNC_MS and writes the snapshots the shards requested,
+   so no shard ever waits on the disk.
+   ------------------------------------------------------------------------- */
+void TradeServer::initializeJournalSync(){
+    bool ok = false;
+    int  ms = qEnvironmentVariableIntValue("JOURNAL_SYNC_MS", &ok);
+    if (!ok || ms <= 0) ms = TradeJournal::DEFAULT_SYNC_MS;
+
+    QList<TradeJournal*> journals;
+    for (EngineShard *shard : shards)
+        journals << shard->tradeJournal();
+
+    QTimer *timer = new QTimer;
+    timer->moveToThread(&journalThread);
+    journalThread.setObjectName("journal-sync");
+    connect(&journalThread, &QThread::started, timer, [timer, ms]() {
+        timer->start(ms);
+    });
+    connect(timer, &QTimer::timeout, timer, [journals]() {
+        for (TradeJournal *j : journals) {
+            j->sync();
+            j->commitSnapshot();
+        }
+    });
+    connect(&journalThread, &QThread::finished, timer, &QObject::deleteLater);
+    journalThread.start();
+}
+
+/* -------------------------------------------------------------------------
+   Load the instrument table and open the combined k-line streams – or,
+   with $MARKET_DATA_REPLAY, play a capture file through the same feed.
+   ------------------------------------------------------------------------- */
+void TradeServer::initializeMarketData(){
+    const QString file = qEnvironmentVariable("CLOUD_INSTRUMENTS");
+    if (!file.isEmpty()) instruments.load(file);
+
+    /* $MARKET_DATA_WS, else the client's $BINANCE_WS_BASE (Mock_Exchange) */
+    QString base = qEnvironmentVariable("MARKET_DATA_WS",
+                       qEnvironmentVariable("BINANCE_WS_BASE",
+                                            "wss://stream.binance.com:9443"));
+    while (base.endsWith('/')) base.chop(1);
+    bool ok = false;
+    int  perConn = qEnvironmentVariableIntValue("MARKET_DATA_STREAMS_PER_CONN",
+                                                &ok);
+    if (!ok || perConn <= 0) perConn = 200;
+
+    /* Feed lives on its own thread; no parent so it can be moved there. */
+    marketData = new MarketDataFeed(instruments, &marketTicks, base, perConn);
+    marketData->setCapture(qEnvironmentVariable("MARKET_DATA_CAPTURE"));
+    marketData->setReplay(qEnvironmentVariable("MARKET_DATA_REPLAY"),
+                          Capture::parseSpeed(
+                              qEnvironmentVariable("MARKET_DATA_REPLAY_SPEED")));
+    marketData->moveToThread(&marketThread);
+    marketThread.setObjectName("market-data");
+    connect(&marketThread, &QThread::started,
+            marketData,    &MarketDataFeed::start);
+    connect(&marketThread, &QThread::finished,
+            marketData,    &QObject::deleteLater);
+    connect(marketData, &MarketDataFeed::ticksReady,
+            this,       &TradeServer::drainMarketTicks,
+            Qt::QueuedConnection);
+    marketThread.start();
+
+    connect(&statsTimer, &QTimer::timeout,
+            this,        &TradeServer::logMarketStats);
+    statsTimer.start(STATS_INTERVAL_MS);
+}
+
+TradeServer::~TradeServer(){
+    journalThread.quit();                 // shards flush their own on delete
+    journalThread.wait();
+    marketThread.quit();
+    marketThread.wait();
+    for (QThread *th : shardThreads) {
+        th->quit();
+        th->wait();
+    }
+    /* shards are gone – drain (or spill) whatever they produced */
+    QMetaObject::invokeMethod(tradeWriter, &TradeWriter::stop,
+                              Qt::BlockingQueuedConnection);
+    writerThread.quit();
+    writerThread.wait();
+    QMetaObject::invokeMethod(analytics, &AnalyticsEngine::stop,
+                              Qt::BlockingQueuedConnection);
+    analyticsThread.quit();
+    analyticsThread.wait();
+}
+
+/* ------------------------------------------------------------------------
+   Consumer side of the SPSC hand-over. Ack first, then drain: the ack's
+   seq_cst fence (paired with one in MarketDataFeed::ingest) means a tick
+   is either seen by this drain or re-arms ticksReady – never stranded.
+   The whole drain goes to every shard as one batch.
+   ------------------------------------------------------------------------ */
+void TradeServer::drainMarketTicks(){
+    marketData->ackTicksReady();
+    QList<EngineShard::PriceTick> batch;
+    MarketTick tick;
+    while (marketTicks.pop(tick)) {
+        onBenchmarkTick(tick.asset, tick.frame.close);
+        batch.append({ tick.asset, tick.frame.close });
+    }
+    if (batch.isEmpty()) return;
+
+    for (EngineShard *shard : shards)
+        QMetaObject::invokeMethod(shard, [shard, batch]() {
+            shard->onPriceTicks(batch);
+        }, Qt::AutoConnection);
+}
+
+void TradeServer::logMarketStats(){
+    qDebug() << "[TradeServer] market queue depth" << marketQueueDepth()
+             << "/" << int(TickRing::capacity())
+             << "high-water" << marketTicks.highWater()
+             << "dropped" << marketTicksDropped();
+
+    const OrderThrottle::Stats o = throttle.stats();
+    qDebug() << "[TradeServer] order intake admitted" << o.admitted
+             << "queued" << o.queued << "rejected" << o.rejected
+             << "pending" << o.pending;
+
+    TradeJournal::Stats j;
+    for (EngineShard *shard : shards) {
+        const TradeJournal::Stats s = shard->tradeJournal()->stats();
+        j.appended  += s.appended;
+        j.snapshots += s.snapshots;
+        j.syncs     += s.syncs;
+        j.usedBytes += s.usedBytes;
+        j.sizeBytes += s.sizeBytes;
     }
-    connect(assetWebSockets[0], &QWebSocket::textMessageReceived,
-            this, &TradeServer::onAsset0Tick);
-    connect(assetWebSockets[1], &QWebSocket::textMessageReceived,
-            this, &TradeServer::onAsset1Tick);
-    connect(assetWebSockets[2], &QWebSocket::textMessageReceived,
-            this, &TradeServer::onAsset2Tick);
-    connect(assetWebSockets[3], &QWebSocket::textMessageReceived,
-            this, &TradeServer::onAsset3Tick);
+    qDebug() << "[TradeServer] journal records" << j.appended
+             << "snapshots" << j.snapshots << "syncs" << j.syncs
+             << "segment bytes" << j.usedBytes << "/" << j.sizeBytes;
+
+    const SlabPool::Stats t = Trade::poolStats();
+    qDebug() << "[TradeServer] trade pool allocations" << t.allocations
+             << "frees" << t.frees << "heap allocations" << t.heapAllocations
+             << "live" << t.live << "peak" << t.peak << "pools" << t.pools;
+
+    const TradeWriter::Stats w = tradeWriter->stats();
+    qDebug() << "[TradeServer] trade writer backlog" << w.backlog
+             << "written" << w.written << "flushes" << w.flushes
+             << "failures" << w.failures << "spilled" << w.spilled
+             << "dead-lettered" << w.deadLettered
+             << "flush ms last/mean/max" << w.lastFlushMs
+             << w.meanFlushMs << w.maxFlushMs;
 }
 
 /* --------------------------- socket lifecycle --------------------------- */
@@ -100,6 +361,8 @@ void TradeServer::onNewConnection(){
     QWebSocket *sock = server->nextPendingConnection();
     connect(sock, &QWebSocket::textMessageReceived,
             this, &TradeServer::onTextMessageReceived);
+    connect(sock, &QWebSocket::binaryMessageReceived,
+            this, &TradeServer::onBinaryMessageReceived);
     connect(sock, &QWebSocket::disconnected,
             this, &TradeServer::onSocketDisconnected);
     qDebug() << "[TradeServer] dashboard socket connected";
@@ -109,6 +372,8 @@ void TradeServer::onSocketDisconnected(){
     QWebSocket *s = qobject_cast<QWebSocket*>(sender());
     int uid = socketUserMap.take(s);
     if (uid != -1) userSessions[uid].removeAll(s);
+    binarySockets.remove(s);
+    publishSessionFormats(uid);
     s->deleteLater();
 }
 
@@ -124,202 +389,258 @@ void TradeServer::onTextMessageReceived(const QString &msg){
         int uid = o["userID"].toInt();
         socketUserMap[sock] = uid;
         userSessions[uid]  << sock;
+
+        /* binary only if the client asked for exactly our version */
+        if (o.value("protocol").toString() == "binary" &&
+            o.value("protocolVersion").toInt() == Wire::VERSION) {
+            binarySockets.insert(sock);
+            QJsonObject ack;
+            ack["type"]            = "protocol";
+            ack["protocol"]        = "binary";
+            ack["protocolVersion"] = Wire::VERSION;
+            sock->sendTextMessage(
+                QJsonDocument(ack).toJson(QJsonDocument::Compact));
+        }
+        publishSessionFormats(uid);
         return;
     }
 
     /* ----- new trade request ------------------------------------------ */
     if (o.contains("newTrade")) {
-        int     uid   = o["userID"].toInt();
-        QString tid   = o["tradeID"].toString();
-        Asset   asset = static_cast<Asset>(o["asset"].toInt());
-        QString pos   = o["position"].toString();
-        double  size  = o["size"].toDouble();
-        double  sl    = o["stopLoss"].toDouble();
-        double  tp    = o["takeProfit"].toDouble();
-        double  open  = livePrices.value(asset, 0.0);
-
-        Trade *t = new Trade(tid, sl, tp, size, asset,
-                             open, o["type"].toString(), pos);
-
-        double diff = (pos == "long") ? (livePrices[asset] - open)
-                                      : (open - livePrices[asset]);
-        usersTradeMap[uid][t] = diff * size;
-
-        /* persist skeleton row */
-        QSqlQuery q(db);
-        q.prepare("INSERT INTO \"Trade_History\" "
-                  "(trade_id,user_id,size,asset,openPrice,closingPrice,pnl,date) "
-                  "VALUES(:id,:u,:s,:a,:op,0,0,:d)");
-        q.bindValue(":id", tid);
-        q.bindValue(":u",  uid);
-        q.bindValue(":s",  size);
-        q.bindValue(":a",  static_cast<int>(asset));
-        q.bindValue(":op", open);
-        q.bindValue(":d",  QDateTime::currentDateTime().toString(Qt::ISODate));
-        q.exec();
-
+        Wire::NewTrade m;
+        m.userID     = o["userID"].toInt();
+        m.clientOrderID = o["clientOrderID"].toString().toULongLong();
+        m.asset      = o["asset"].toInt();
+        m.side       = Wire::sideFromString(o["position"].toString());
+        m.orderType  = o["type"].toString();
+        m.size       = o["size"].toDouble();
+        m.stopLoss   = o["stopLoss"].toDouble();
+        m.takeProfit = o["takeProfit"].toDouble();
+        admitOrder(sock, m);
         return;
     }
 
     /* ----- close trade request ---------------------------------------- */
     if (o.contains("closeTrade")) {
-        closeTrade(o["userID"].toInt(), o["tradeID"].toString());
+        const int uid = o["userID"].toInt();
+        if (isSessionUser(sock, uid))
+            routeClose(uid, TradeIds::fromString(o["tradeID"].toString()));
     }
 }
 
-/* ------------------------- PnL helpers --------------------------------- */
-double TradeServer::getTotalPnL(int uid){
-    double tot = 0.0;
-    for (double p : usersTradeMap[uid].values()) tot += p;
-    return tot;
-}
+/* Same two requests as above, WireProtocol‑encoded ---------------------- */
+void TradeServer::onBinaryMessageReceived(const QByteArray &frame){
+    QWebSocket *sock = qobject_cast<QWebSocket*>(sender());
+    Wire::Reader r(frame);
+    if (!r.good()) return;
 
-void TradeServer::updateAssetPnL(int uid, Asset asset){
-    for (auto it = usersTradeMap[uid].begin();
-         it != usersTradeMap[uid].end(); ++it)
-    {
-        Trade *t = it.key();
-        if (t->getAsset() != asset) continue;
-
-        double diff = (t->getPosition() == "long")
-                          ? (livePrices[asset] - t->getOpenPrice())
-                          : (t->getOpenPrice() - livePrices[asset]);
-        it.value() = diff * t->getSize();
+    switch (r.msg()) {
+    case Wire::Msg::NewTrade: {
+        Wire::NewTrade m;
+        if (Wire::decode(r, m)) admitOrder(sock, m);
+        break;
+    }
+    case Wire::Msg::CloseTrade: {
+        Wire::CloseTrade m;
+        if (Wire::decode(r, m) && isSessionUser(sock, m.userID))
+            routeClose(m.userID, m.tradeID);
+        break;
+    }
+    default:
+        break;
     }
 }
 
-void TradeServer::checkLimits(int uid, Asset asset){
-    for (Trade *t : usersTradeMap[uid].keys()) {
-        if (t->getAsset() != asset) continue;
+/* ------------------------- shard routing -------------------------------- */
+EngineShard *TradeServer::shardFor(int uid) const{
+    const uint n = uint(shards.size());
+    return shards[int(uint(uid) % n)];
+}
 
-        double px = livePrices[asset];
-        bool hit  = (t->getPosition() == "long")
-                       ? (px >= t->getTakeProfit() || px <= t->getStopLoss())
-                       : (px <= t->getTakeProfit() || px >= t->getStopLoss());
+/* A socket acts only for the user it registered as in its tradeDashboard
+   handshake; anything else is logged and dropped. */
+bool TradeServer::isSessionUser(QWebSocket *sock, int uid) const{
+    const int own = socketUserMap.value(sock, -1);
+    if (own == uid) return true;
+    if (own == -1)
+        qWarning() << "[TradeServer] request before tradeDashboard handshake – dropped";
+    else
+        qWarning() << "[TradeServer] socket of user" << own
+                   << "sent a request for user" << uid << "– dropped";
+    return false;
+}
 
-        if (hit) closeTrade(uid, t->getTradeID());
+/* ------------------------------------------------------------------------
+   Intake back‑pressure: over‑rate orders are parked (drained by
+   drainThrottle) or, once the user's queue is full, rejected. Keyed on
+   the socket's user, so nobody can spend another user's budget.
+   ------------------------------------------------------------------------ */
+void TradeServer::admitOrder(QWebSocket *sock, const Wire::NewTrade &m){
+    if (!isSessionUser(sock, m.userID)) {
+        const int own = socketUserMap.value(sock, -1);
+        if (own != -1)
+            onOrderAck(own, m.clientOrderID, 0, RiskVerdict::WrongUser);
+        return;
     }
+    switch (throttle.submit(m, intakeClock.nsecsElapsed())) {
+    case OrderThrottle::Admitted:
+        routeOpen(m);
+        return;
+    case OrderThrottle::Rejected:
+        onOrderAck(m.userID, m.clientOrderID, 0, RiskVerdict::RateLimited);
+        break;
+    case OrderThrottle::Queued:
+        break;
+    }
+    throttleDirty.insert(m.userID);
+    if (!throttleTimer.isActive()) throttleTimer.start(THROTTLE_DRAIN_MS);
 }
 
-/* Broadcast a snapshot of one user’s open trade & PnL ------------------- */
-void TradeServer::tradeDashboardUpdate(int uid, Asset asset){
-    for (Trade *t : usersTradeMap[uid].keys()) {
-        if (t->getAsset() != asset) continue;
-
-        QJsonObject obj;
-        obj["type"]       = "open";
-        obj["userID"]     = uid;
-        obj["tradeID"]    = t->getTradeID();
-        obj["stopLoss"]   = t->getStopLoss();
-        obj["takeProfit"] = t->getTakeProfit();
-        obj["size"]       = t->getSize();
-        obj["asset"]      = static_cast<int>(asset);
-        obj["openPrice"]  = t->getOpenPrice();
-        obj["position"]   = t->getPosition();
-        obj["pnl"]        = usersTradeMap[uid][t];
-
-        const QString msg =
-            QJsonDocument(obj).toJson(QJsonDocument::Compact);
-        for (QWebSocket *s : userSessions[uid])
-            if (s) s->sendTextMessage(msg);
+void TradeServer::drainThrottle(){
+    for (const Wire::NewTrade &m : throttle.release(intakeClock.nsecsElapsed())) {
+        if (throttle.queued(m.userID) == 0) throttleDirty.insert(m.userID);
+        routeOpen(m);
     }
+    for (int uid : std::as_const(throttleDirty))
+        sendThrottle(uid);
+    throttleDirty.clear();
+
+    if (!throttle.hasPending()) throttleTimer.stop();
 }
 
-/* ------------------------------------------------------------------ */
-void TradeServer::closeTrade(int uid, const QString &tid){
-    for (Trade *t : usersTradeMap[uid].keys()) {
-        if (t->getTradeID() != tid) continue;
-
-        double live = livePrices[t->getAsset()];
-        double diff = (t->getPosition() == "long")
-                          ? (live - t->getOpenPrice())
-                          : (t->getOpenPrice() - live);
-        double pnl  = diff * t->getSize();
-
-        /* persist closing price & PnL */
-        QSqlQuery q(db);
-        q.prepare("UPDATE \"Trade_History\" SET "
-                  "closingPrice=:cp, pnl=:p, date=:d "
-                  "WHERE trade_id=:id");
-        q.bindValue(":cp", live);
-        q.bindValue(":p",  pnl);
-        q.bindValue(":d",  QDateTime::currentDateTime().toString(Qt::ISODate));
-        q.bindValue(":id", tid);
-        q.exec();
-
-        /* feed realised trade into alpha model */
-        const QDate today = QDate::currentDate();
-        double rp = (live - t->getOpenPrice()) / t->getOpenPrice();
-        double w  = std::abs(t->getSize() * t->getOpenPrice());
-        alphaCalc.addTrade(uid, today, rp, w);
-
-        usersTradeMap[uid].remove(t);
-        emit tradeClosed(uid, pnl);
-
-        /* >>> NEW: notify live dashboards that the trade is gone <<< */
-        if (userSessions.contains(uid)) {
-            QJsonObject obj;
-            obj["type"]    = "closed";
-            obj["userID"]  = uid;
-            obj["tradeID"] = tid;
-            obj["pnl"]     = pnl;
-            const QString msg =
-                QJsonDocument(obj).toJson(QJsonDocument::Compact);
-            for (QWebSocket *s : userSessions[uid])
-                if (s) s->sendTextMessage(msg);
-        }
-        /* ----------------------------------------------------------- */
+/* Current queued / rejected counts for one user, at most once per drain */
+void TradeServer::sendThrottle(int uid){
+    Wire::Throttle m;
+    m.userID   = uid;
+    m.queued   = throttle.queued(uid);
+    m.rejected = int(throttle.rejected(uid));
+
+    QJsonObject obj;
+    obj["type"]     = "throttle";
+    obj["userID"]   = uid;
+    obj["queued"]   = m.queued;
+    obj["rejected"] = m.rejected;
+    sendToUser(uid, QJsonDocument(obj).toJson(QJsonDocument::Compact),
+               Wire::encode(m));
+}
 
-        delete t;
-        break;
-    }
+/* Account half of the risk gate runs here, next to the ledger; the shard
+   gets a copy of the row and checks the rest against its own books. */
+void TradeServer::routeOpen(const Wire::NewTrade &m){
+    const AccountRecord *acc = accountServer ? accountServer->account(m.userID)
+                                             : nullptr;
+    if (!acc)         { onOrderAck(m.userID, m.clientOrderID, 0, RiskVerdict::UnknownAccount); return; }
+    if (!acc->active) { onOrderAck(m.userID, m.clientOrderID, 0, RiskVerdict::AccountLocked);  return; }
+
+    EngineShard        *shard    = shardFor(m.userID);
+    const AccountRecord snapshot = *acc;
+    QMetaObject::invokeMethod(shard, [shard, m, snapshot]() {
+        shard->openTrade(m, snapshot);
+    }, Qt::AutoConnection);
+}
+
+void TradeServer::routeClose(int uid, TradeId tid){
+    EngineShard *shard = shardFor(uid);
+    QMetaObject::invokeMethod(shard, [shard, uid, tid]() {
+        shard->closeTrade(uid, tid);
+    }, Qt::AutoConnection);
 }
 
 void TradeServer::onCloseAllTrades(int uid){
-    for (Trade *t : usersTradeMap[uid].keys())
-        closeTrade(uid, t->getTradeID());
+    EngineShard *shard = shardFor(uid);
+    QMetaObject::invokeMethod(shard, [shard, uid]() {
+        shard->closeAllTrades(uid);
+    }, Qt::AutoConnection);
 }
 
-/* Helper – extract candle close price from Binance kline JSON */
-static inline double extractClose(const QString &msg){
-    QJsonDocument d = QJsonDocument::fromJson(msg.toUtf8());
-    return d.object()["k"].toObject()["c"].toString().toDouble();
+/* Tell the owning shard which encodings this user's dashboards speak */
+void TradeServer::publishSessionFormats(int uid){
+    SessionFormats f;
+    for (QWebSocket *s : userSessions.value(uid)) {
+        if (binarySockets.contains(s)) f.binary = true;
+        else                           f.json   = true;
+    }
+    if (!f.any()) userSessions.remove(uid);
+
+    EngineShard *shard = shardFor(uid);
+    QMetaObject::invokeMethod(shard, [shard, uid, f]() {
+        shard->setSessionFormats(uid, f);
+    }, Qt::AutoConnection);
 }
 
-/* ----------------------------------------------------------------------
-   Macro generates four near-identical tick handlers (BTC, ETH, SOL, XRP)
-   ---------------------------------------------------------------------- */
-#define HANDLE_TICK(N, ENUM)                                             \
-void TradeServer::onAsset ## N ## Tick(const QString &msg){              \
-        const double px = extractClose(msg);                             \
-        livePrices[ENUM] = px;                                           \
-        const QDate today = QDate::currentDate();                        \
-        /* BTC stream also drives benchmark return */                    \
-        if (ENUM == Asset::BTCUSDT) {                                    \
-            if (today != currentDay) {                                   \
-                currentDay = today;                                      \
-                benchOpen  = px;                                         \
-        }                                                                \
-            if (QTime::currentTime().hour() == 23 &&                     \
-                                                                             QTime::currentTime().minute() >= 59) {                   \
-                double rb = (px - benchOpen) / benchOpen;                \
-                alphaCalc.addBenchmark(0, currentDay, rb, 1.0);          \
-        }                                                                \
-    }                                                                    \
-        /* risk + PnL updates */                                         \
-        for (int uid : usersTradeMap.keys()) {                           \
-            checkLimits(uid, ENUM);                                      \
-            updateAssetPnL(uid, ENUM);                                   \
-    }                                                                    \
-        for (int uid : accountServer->getUserSessions().keys()) {        \
-            emit equityUpdate(uid, getTotalPnL(uid));                    \
-            tradeDashboardUpdate(uid, ENUM);                             \
-    }                                                                    \
+/* Each socket gets the payload in the format it negotiated */
+void TradeServer::sendToUser(int uid, const QString &json,
+                             const QByteArray &binary){
+    for (QWebSocket *s : userSessions.value(uid)) {
+        if (!s) continue;
+        if (binarySockets.contains(s)) {
+            if (!binary.isEmpty()) s->sendBinaryMessage(binary);
+        } else if (!json.isEmpty()) {
+            s->sendTextMessage(json);
+        }
+    }
 }
 
-HANDLE_TICK(0, Asset::BTCUSDT)
-HANDLE_TICK(1, Asset::ETHUSDT)
-HANDLE_TICK(2, Asset::SOLUSDT)
-HANDLE_TICK(3, Asset::XRPUSDT)
+/* Accept / reject reply for one order, in each socket's format ----------- */
+void TradeServer::onOrderAck(int uid, quint64 clientOrderID, TradeId tid,
+                             RiskVerdict v){
+    Wire::OrderAck m;
+    m.userID        = uid;
+    m.clientOrderID = clientOrderID;
+    m.tradeID       = tid;
+    m.accepted      = v == RiskVerdict::Accepted;
+    m.code          = static_cast<quint8>(v);
+    m.reason        = RiskGate::reason(v);
+    if (!m.accepted)
+        qDebug() << "[TradeServer] order" << clientOrderID << "of user" << uid
+                 << "rejected:" << m.reason;
+
+    QJsonObject obj;
+    obj["type"]          = "orderAck";
+    obj["userID"]        = uid;
+    obj["clientOrderID"] = QString::number(clientOrderID);
+    obj["tradeID"]       = TradeIds::toString(tid);
+    obj["accepted"]      = m.accepted;
+    obj["code"]          = int(m.code);
+    obj["reason"]        = m.reason;
+    sendToUser(uid, QJsonDocument(obj).toJson(QJsonDocument::Compact),
+               Wire::encode(m));
+}
+
+/* ------------------------------------------------------------------------
+   Shard → server: queue the row for TradeWriter, feed the analytics
+   engine and notify accounts. No SQL on this thread.
+   ------------------------------------------------------------------------ */
+void TradeServer::onTradeEvent(const TradeEvent &e){
+    tradeWriter->enqueue(e);
+    if (e.kind != TradeEvent::Closed) return;
+
+    /* feed realised trade into the analytics engine (its own thread) */
+    AnalyticsEngine *a = analytics;
+    QMetaObject::invokeMethod(a, [a, e]() { a->addTrade(e); });
+
+    emit tradeClosed(e);                           // row travels with the event
+}
 
-#undef HANDLE_TICK
+/* ----------------------------------------------------------------------
+   BTC stream also drives the benchmark return (server thread only)
+   ---------------------------------------------------------------------- */
+void TradeServer::onBenchmarkTick(Asset asset, double px){
+    if (asset != Asset::BTCUSDT) return;
+
+    /* a day's return is final on the first tick of the next day – post it
+       once; the analytics engine shares it across every user */
+    const QDate today = QDate::currentDate();
+    if (today != currentDay) {
+        if (benchOpen > 0.0 && benchLast > 0.0) {
+            const QDate  day = currentDay;
+            const double rb  = (benchLast - benchOpen) / benchOpen;
+            AnalyticsEngine *a = analytics;
+            QMetaObject::invokeMethod(a, [a, day, rb]() { a->addBenchmark(day, rb); });
+        }
+        currentDay = today;
+        benchOpen  = px;
+    }
+    if (benchOpen <= 0.0) benchOpen = px;         // first tick after start‑up
+    benchLast = px;
+}
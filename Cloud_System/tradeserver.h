@@ -5,20 +5,75 @@
    risk checks.
 
    Key features
-   • WebSocket edge – one listening socket for trader GUIs plus four outbound
-     sockets to market‑data streams (Asset0‑3).
-   • Per‑user trade map lets us mark‑to‑market positions in O(#positions) on
-     each tick.
+   • WebSocket edge – one listening socket for trader GUIs plus a
+     MarketDataFeed that multiplexes every symbol in the InstrumentTable
+     over a few combined‑stream sockets.
+   • Sharded engine – users are partitioned across EngineShards (userID %
+     N), each on its own thread with private position maps; every tick is
+     broadcast to all shards, so tick‑to‑update latency depends on users
+     per shard rather than total users.
    • Emits equityUpdate(user, totalPnL) so AccountServer can enforce
      draw‑down limits.
+   • Dashboard fan‑out is batched: one "positions" frame per user per tick
+     carries every open trade in the ticking asset.
+   • Wire format is per socket: dashboards that ask for "binary" in the
+     handshake get WireProtocol frames, the rest keep compact JSON. Each
+     payload is encoded at most once per format per event.
 
    Design notes
-   • Tick fan‑in: each asset tick handler updates livePrices and then walks
-     only the affected users’ trades, avoiding global scans.
-   • BenchOpen captured at session start – used to derive benchmark return
-     for AlphaCalculator.
-   • All DB writes funnel through prepared statements (see TradeServer.cpp).
-   • TODO: back‑pressure guard if trader floods orders >100/s.
+   • Tick fan‑in: each ring drain is posted to every shard as one batch;
+     a shard touches only the ticking asset's books for its own users.
+   • $ENGINE_SHARDS sets the worker‑thread count (0 / unset = one inline
+     shard on this thread, the original single‑threaded engine);
+     $ENGINE_PIN_CPUS=1 pins each worker to its own core.
+   • Sockets and SQL stay on this thread (analytics runs on its own, see
+     AnalyticsEngine): shards emit TradeEvents / pre‑encoded dashboard
+     payloads, and the session encodings a user negotiated are pushed to
+     the owning shard.
+   • Market data is received and decoded on a dedicated thread and handed
+     over through an SPSC ring (marketTicks), so a slow QSqlQuery here
+     delays the drain, not the socket reads. Depth / drops / high‑water
+     are logged every STATS_INTERVAL_MS and exposed via getters.
+   • Feed config comes from the environment: $CLOUD_INSTRUMENTS (symbol
+     file), $MARKET_DATA_WS (base URL; falls back to $BINANCE_WS_BASE, so
+     one variable points both engine and client at Mock_Exchange) and
+     $MARKET_DATA_STREAMS_PER_CONN. $MARKET_DATA_CAPTURE records every raw
+     frame to a capture file; $MARKET_DATA_REPLAY plays one back instead
+     of connecting, at $MARKET_DATA_REPLAY_SPEED (1 = real time, N, max).
+   • Inside a shard, SL/TP hits come from a per‑asset TriggerBook and PnL
+     from a columnar PositionStore (see EngineShard.h).
+   • BenchOpen captured at session start – used to derive the daily
+     benchmark return, posted once per day to the single AnalyticsEngine.
+     Its 30‑day trade history is warmed in bulk (AnalyticsEngine::warmUp)
+     before the socket starts listening.
+   • Orders pass a server‑side RiskGate before they are filled: routeOpen
+     snapshots the account row from AccountServer's ledger (unknown /
+     locked accounts are refused right here), the owning shard runs the
+     equity / max‑loss / position‑limit rules, and every order gets an
+     "orderAck" (JSON) or OrderAck (binary) reply with accept / reason.
+   • Trade IDs are 64‑bit TradeIds minted by the shard at fill and
+     returned in the orderAck together with the client's clientOrderID;
+     JSON carries both as decimal strings.
+   • Trade_History writes are write‑behind: TradeEvents are queued to a
+     TradeWriter on its own thread / connection and committed in batches,
+     so no order or tick ever waits on Postgres here. Writer backlog and
+     flush latency are logged alongside the market‑data stats.
+   • Order back‑pressure: every newTrade passes an OrderThrottle (per‑user
+     and global token buckets) before it reaches a shard. Buckets and
+     routing are keyed on the user the socket registered as; an order or
+     close naming another userID is refused (WrongUser orderAck). Over‑rate
+     orders are parked per user and released round‑robin every
+     THROTTLE_DRAIN_MS; past the per‑user queue limit they are rejected
+     with an orderAck. Queued / rejected counts go back to the dashboard
+     as a coalesced "throttle" report, so a flooding client only ever
+     slows itself down and cannot crowd out tick processing.
+   • Restart safety: each shard journals fills / closes into a mmap'd
+     TradeJournal. On start the server merges the snapshots + journal
+     tails in $JOURNAL_DIR, hands every position to the shard that owns
+     its user and only then accepts orders – Trade_History is never
+     scanned. A "journal-sync" thread msyncs all journals and writes the
+     snapshots the shards requested every $JOURNAL_SYNC_MS, off the tick
+     path.
    ========================================================================= */
 
 #ifndef TRADESERVER_H
@@ -26,14 +81,23 @@
 
 #include "qsqldatabase.h"
 #include "qwebsocketserver.h"
-#include "trade.h"
-#include "alphacalculator.h"
+#include "analyticsengine.h"
+#include "engineshard.h"
+#include "instrumenttable.h"
+#include "marketdatafeed.h"
+#include "orderthrottle.h"
+#include "tradewriter.h"
+#include "wireprotocol.h"
 
 #include <QObject>
 #include <QHash>
 #include <QMap>
 #include <QList>
+#include <QSet>
 #include <QWebSocket>
+#include <QThread>
+#include <QTimer>
+#include <QElapsedTimer>
 
 
 
@@ -43,14 +107,22 @@ class TradeServer : public QObject
 {
     Q_OBJECT
 public:
+    static constexpr int STATS_INTERVAL_MS = 10000;
+    static constexpr int THROTTLE_DRAIN_MS = 5;
+
     explicit TradeServer(quint16 port, QObject *parent = nullptr);
+    ~TradeServer();
 
     void setAccountServer(AccountServer *accountserver);
 
-    double getTotalPnL(int userID);
+    int shardCount() const { return shards.size(); }
+
+    /* market‑data hand‑over health */
+    int     marketQueueDepth()   const { return int(marketTicks.size()); }
+    quint64 marketTicksDropped() const { return marketTicks.dropped(); }
 
 signals:
-    void tradeClosed (int userID, double pnl);
+    void tradeClosed (const TradeEvent &closed);
     void equityUpdate(int userID, double totalPnL);
 
 private slots:
@@ -58,32 +130,61 @@ private slots:
 
     void onNewConnection();
     void onTextMessageReceived(const QString &message);
+    void onBinaryMessageReceived(const QByteArray &frame);
     void onSocketDisconnected();
 
-    void onAsset0Tick(const QString &message);
-    void onAsset1Tick(const QString &message);
-    void onAsset2Tick(const QString &message);
-    void onAsset3Tick(const QString &message);
+    void drainMarketTicks();
+    void logMarketStats();
+    void drainThrottle();
+
+    /* shard → server (queued when the shard runs on a worker thread) */
+    void onTradeEvent(const TradeEvent &event);
+    void onOrderAck(int userID, quint64 clientOrderID, TradeId tradeID,
+                    RiskVerdict verdict);
+    void sendToUser(int userID, const QString &json, const QByteArray &binary);
 
 private:
-    void initializeAssetWebSockets();
-    void updateAssetPnL(int userID, Asset asset);
-    void checkLimits   (int userID, Asset asset);
-    void tradeDashboardUpdate(int userID, Asset asset);
-    void closeTrade(int userID, const QString &tradeID);
+    void initializeAnalytics();
+    void initializePersistence();
+    void initializeEngine();
+    void initializeJournalSync();
+    void initializeMarketData();
+    void onBenchmarkTick(Asset asset, double price);
+
+    EngineShard *shardFor(int userID) const;
+    bool isSessionUser(QWebSocket *socket, int userID) const;
+    void admitOrder(QWebSocket *socket, const Wire::NewTrade &order);
+    void routeOpen (const Wire::NewTrade &order);
+    void routeClose(int userID, TradeId tradeID);
+    void publishSessionFormats(int userID);
+    void sendThrottle(int userID);
 
     QWebSocketServer                 *server;
     AccountServer                    *accountServer {nullptr};
     QHash<QWebSocket*, int>           socketUserMap;
-    QMap<int, QMap<Trade*, double>>   usersTradeMap;
     QMap<int, QList<QWebSocket*>>     userSessions;
-    QList<QWebSocket*>                assetWebSockets;
-    QMap<Asset, double>               livePrices;
-    QSqlDatabase                     &db;
-    AlphaCalculator                   alphaCalc;
+    QSet<QWebSocket*>                 binarySockets;  // negotiated WireProtocol
+    InstrumentTable                   instruments;
+    MarketDataFeed                   *marketData {nullptr};
+    QThread                           marketThread;
+    TickRing                          marketTicks;
+    QTimer                            statsTimer;
+    OrderThrottle                     throttle;
+    QElapsedTimer                     intakeClock;
+    QTimer                            throttleTimer;
+    QSet<int>                         throttleDirty;  // users owed a report
+    QString                           dataDir;        // journal + TradeWriter spill
+    QList<EngineShard*>               shards;
+    QList<QThread*>                   shardThreads;   // empty when inline
+    QThread                           journalThread;  // background msync
+    TradeWriter                      *tradeWriter {nullptr};
+    QThread                           writerThread;
+    AnalyticsEngine                  *analytics {nullptr};
+    QThread                           analyticsThread;
 
     QDate                             currentDay { QDate::currentDate() };
     double                            benchOpen  { 0.0 };
+    double                            benchLast  { 0.0 };
 };
 
 #endif // TRADESERVER_H
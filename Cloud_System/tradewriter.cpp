@@ -0,0 +1,331 @@
+/* =========================================================================
+   TradeWriter.cpp – implementation of TradeWriter.h
+   -------------------------------------------------------------------------
+   Queue → batch → one transaction per batch, with a disk spill behind the
+   in‑memory backlog.
+   ========================================================================= */
+
+#include "tradewriter.h"
+#include "DatabaseManager.h"
+
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QtDebug>
+
+namespace {
+
+QDataStream &operator<<(QDataStream &s, const TradeEvent &e){
+    return s << quint8(e.kind) << qint32(e.userID) << quint64(e.tradeID)
+             << qint32(e.asset) << e.size << e.openPrice << e.closePrice
+             << e.pnl << e.at;
+}
+
+QDataStream &operator>>(QDataStream &s, TradeEvent &e){
+    quint8 kind; qint32 uid, asset; quint64 tid;
+    s >> kind >> uid >> tid >> asset >> e.size >> e.openPrice
+      >> e.closePrice >> e.pnl >> e.at;
+    e.kind   = static_cast<TradeEvent::Kind>(kind);
+    e.userID  = uid;
+    e.tradeID = tid;
+    e.asset   = static_cast<Asset>(asset);
+    return s;
+}
+
+/* Rows per statement: a batch is cut into the binary decomposition of its
+   size, so only these texts ever reach the prepared‑statement cache. */
+constexpr int STATEMENT_ROWS[] = { 500, 256, 128, 64, 32, 16, 8, 4, 2, 1 };
+
+QList<int> pieces(int n){
+    QList<int> out;
+    for (int rows : STATEMENT_ROWS)
+        while (n >= rows) { out << rows; n -= rows; }
+    return out;
+}
+
+QString valuesList(const QString &row, int n){
+    QStringList rows;
+    rows.reserve(n);
+    for (int i = 0; i < n; ++i) rows << row;
+    return rows.join(',');
+}
+
+/* After a failed statement: is the session still there? A dead one is
+   closed so DatabaseManager reconnects on the next connection() call. */
+bool connectionAlive(QSqlDatabase &db){
+    if (db.isOpen()) {
+        QSqlQuery probe(db);
+        if (probe.exec("SELECT 1")) return true;
+    }
+    db.close();
+    return false;
+}
+
+} // namespace
+
+TradeWriter::TradeWriter(const QString &spillPath, QObject *parent)
+    : QObject(parent),
+    spill(spillPath),
+    dead(spillPath + ".dead")
+{
+    if (!spill.open(QIODevice::ReadWrite | QIODevice::Append |
+                    QIODevice::Unbuffered))
+        qWarning() << "[TradeWriter] cannot open spill file" << spillPath;
+    else if (spill.size() > 0) {
+        spilling = true;                  // left over from a previous run
+        qWarning() << "[TradeWriter] replaying" << spill.size()
+                   << "spilled bytes from" << spillPath;
+    }
+}
+
+/* ------------------------------------------------------------------------
+   Producer side. Kicks the writer thread once BATCH_ROWS are waiting
+   instead of waiting for the timer.
+   ------------------------------------------------------------------------ */
+void TradeWriter::enqueue(const TradeEvent &e){
+    bool wake = false;
+    {
+        QMutexLocker lock(&mutex);
+        if (spilling || queue.size() >= std::size_t(MAX_BACKLOG))
+            spillLocked(e);
+        else
+            queue.push_back(e);
+        wake = queue.size() >= std::size_t(BATCH_ROWS);
+    }
+    if (wake && !wakePending.exchange(true, std::memory_order_acq_rel))
+        QMetaObject::invokeMethod(this, &TradeWriter::flush,
+                                  Qt::QueuedConnection);
+}
+
+TradeWriter::Stats TradeWriter::stats() const{
+    QMutexLocker lock(&mutex);
+    Stats s = counters;
+    s.backlog = int(queue.size());
+    return s;
+}
+
+void TradeWriter::spillLocked(const TradeEvent &e){
+    if (!spilling)
+        qWarning() << "[TradeWriter] backlog full – spilling to" << spill.fileName();
+    spilling = true;
+    QDataStream out(&spill);
+    out << e;
+    ++counters.spilled;
+}
+
+/* Pull the next chunk of spilled events back into memory (queue is empty). */
+void TradeWriter::loadSpillLocked(){
+    if (!spill.isOpen() || !spill.seek(spillReadPos)) {
+        spilling = false;                          // nothing readable
+        return;
+    }
+
+    QDataStream in(&spill);
+    const int chunk = BATCH_ROWS * MAX_BATCHES;
+    for (int n = 0; n < chunk && !in.atEnd(); ++n) {
+        TradeEvent e;
+        in >> e;
+        if (in.status() != QDataStream::Ok) {
+            qWarning() << "[TradeWriter] truncated spill record – discarding tail";
+            spillReadPos = spill.size();
+            break;
+        }
+        queue.push_back(e);
+    }
+    if (spillReadPos < spill.pos()) spillReadPos = spill.pos();
+
+    if (spillReadPos >= spill.size()) {      // fully replayed
+        spill.resize(0);
+        spillReadPos = 0;
+        spilling     = false;
+        qDebug() << "[TradeWriter] spill drained";
+    }
+}
+
+/* ------------------------------ writer thread --------------------------- */
+void TradeWriter::start(){
+    timer = new QTimer(this);
+    connect(timer, &QTimer::timeout, this, &TradeWriter::flush);
+    timer->start(FLUSH_MS);
+    qDebug() << "[TradeWriter] using"
+             << DatabaseManager::getInstance().connection().connectionName();
+}
+
+void TradeWriter::flush(){
+    wakePending.store(false, std::memory_order_release);
+    if (!DatabaseManager::getInstance().connection().isOpen()) return;
+
+    for (int n = 0; n < MAX_BATCHES; ++n) {
+        QList<TradeEvent> batch;
+        {
+            QMutexLocker lock(&mutex);
+            if (queue.empty() && spilling) loadSpillLocked();
+            const int take = int(qMin(queue.size(), std::size_t(BATCH_ROWS)));
+            batch.reserve(take);
+            for (int i = 0; i < take; ++i) {
+                batch << std::move(queue.front());
+                queue.pop_front();
+            }
+        }
+        if (batch.isEmpty()) return;
+
+        QElapsedTimer clock;
+        clock.start();
+        int done = 0;                             // leading events settled
+        const quint64 deadBefore = stats().deadLettered;
+        WriteResult r = writeBatch(batch);
+        if (r == WriteResult::Ok) done = int(batch.size());
+        if (r == WriteResult::Rejected && ++attempts >= MAX_ATTEMPTS) {
+            qWarning() << "[TradeWriter] batch of" << batch.size() << "rejected"
+                       << attempts << "times – isolating bad rows";
+            r = writeIsolating(batch, done);
+        }
+        const double ms = clock.nsecsElapsed() / 1e6;
+
+        QMutexLocker lock(&mutex);
+        if (r != WriteResult::Ok) {               // unsettled tail back, in order
+            ++counters.failures;
+            for (int i = int(batch.size()) - 1; i >= done; --i)
+                queue.push_front(batch[i]);
+            return;
+        }
+        attempts = 0;
+        counters.written    += quint64(batch.size())
+                               - (counters.deadLettered - deadBefore);
+        counters.flushes    += 1;
+        counters.lastFlushMs = ms;
+        counters.maxFlushMs  = qMax(counters.maxFlushMs, ms);
+        counters.meanFlushMs += (ms - counters.meanFlushMs) / double(counters.flushes);
+    }
+}
+
+/* Drain on shutdown; whatever cannot be written goes to the spill file. */
+void TradeWriter::stop(){
+    if (timer) timer->stop();
+    for (;;) {                                     // until nothing moves
+        const quint64 written = stats().written;
+        flush();
+        if (stats().written == written) break;
+    }
+
+    /* DB down – keep for next run. Queued events are older than anything
+       still on disk, so pull the spill in behind them and rewrite it. */
+    QMutexLocker lock(&mutex);
+    if (queue.empty()) return;
+    while (spilling) loadSpillLocked();
+    while (!queue.empty()) {
+        QDataStream out(&spill);
+        out << queue.front();
+        queue.pop_front();
+        ++counters.spilled;
+    }
+    spill.flush();
+}
+
+/* ------------------------------------------------------------------------
+   One transaction: multi‑row INSERTs for opens, then UPDATE … FROM
+   (VALUES …) for closes, each cut into STATEMENT_ROWS pieces.
+   ------------------------------------------------------------------------ */
+TradeWriter::WriteResult TradeWriter::writeBatch(const QList<TradeEvent> &batch){
+    DatabaseManager &dbm = DatabaseManager::getInstance();
+    QSqlDatabase    &db  = dbm.connection();
+
+    QList<const TradeEvent*> opens, closes;
+    for (const TradeEvent &e : batch)
+        (e.kind == TradeEvent::Opened ? opens : closes) << &e;
+
+    if (!db.transaction()) {
+        qWarning() << "[TradeWriter] BEGIN failed:" << db.lastError().text();
+        db.close();                                // force a reconnect
+        return WriteResult::ConnectionLost;
+    }
+
+    auto fail = [&db](const char *what, const QSqlError &err) {
+        qWarning() << "[TradeWriter]" << what << "failed:" << err;
+        db.rollback();
+        return connectionAlive(db) ? WriteResult::Rejected
+                                   : WriteResult::ConnectionLost;
+    };
+
+    int next = 0;
+    for (int n : pieces(int(opens.size()))) {
+        QSqlQuery &q = dbm.prepared(
+            "INSERT INTO \"Trade_History\" "
+            "(trade_id,user_id,size,asset,openPrice,closingPrice,pnl,date) "
+            "VALUES " + valuesList("(?,?,?,?,?,0,0,CAST(? AS timestamptz))", n));
+        for (int i = 0; i < n; ++i) {
+            const TradeEvent *e = opens[next++];
+            q.addBindValue(TradeIds::toString(e->tradeID));
+            q.addBindValue(e->userID);
+            q.addBindValue(e->size);
+            q.addBindValue(static_cast<int>(e->asset));
+            q.addBindValue(e->openPrice);
+            q.addBindValue(e->at);
+        }
+        if (!q.exec()) return fail("INSERT", q.lastError());
+    }
+
+    next = 0;
+    for (int n : pieces(int(closes.size()))) {
+        QSqlQuery &q = dbm.prepared(
+            "UPDATE \"Trade_History\" AS t SET "
+            "closingPrice = v.cp, pnl = v.p, date = v.d "
+            "FROM (VALUES (CAST(? AS text),CAST(? AS float8),"
+            "CAST(? AS float8),CAST(? AS timestamptz))"
+            + (n > 1 ? "," + valuesList("(?,?,?,?)", n - 1) : QString()) +
+            ") AS v(id,cp,p,d) "
+            "WHERE t.trade_id = v.id");
+        for (int i = 0; i < n; ++i) {
+            const TradeEvent *e = closes[next++];
+            q.addBindValue(TradeIds::toString(e->tradeID));
+            q.addBindValue(e->closePrice);
+            q.addBindValue(e->pnl);
+            q.addBindValue(e->at);
+        }
+        if (!q.exec()) return fail("UPDATE", q.lastError());
+    }
+
+    if (!db.commit()) return fail("COMMIT", db.lastError());
+    return WriteResult::Ok;
+}
+
+/* Bisect a batch that keeps failing on a live connection: every half that
+   commits is done, a single event that is still rejected is dead‑lettered.
+   @p done counts the leading events settled either way, so on a lost
+   connection only the unsettled tail is retried. */
+TradeWriter::WriteResult TradeWriter::writeIsolating(const QList<TradeEvent> &batch,
+                                                     int &done){
+    const WriteResult r = writeBatch(batch);
+    if (r == WriteResult::Ok) { done += int(batch.size()); return r; }
+    if (r == WriteResult::ConnectionLost) return r;
+
+    if (batch.size() == 1) {
+        deadLetter(batch.front());
+        ++done;
+        return WriteResult::Ok;
+    }
+    const int half = int(batch.size()) / 2;
+    const WriteResult left = writeIsolating(batch.mid(0, half), done);
+    if (left != WriteResult::Ok) return left;
+    return writeIsolating(batch.mid(half), done);
+}
+
+void TradeWriter::deadLetter(const TradeEvent &e){
+    qWarning() << "[TradeWriter] dead-lettering"
+               << (e.kind == TradeEvent::Opened ? "open" : "close")
+               << "of trade" << TradeIds::toString(e.tradeID) << "user" << e.userID
+               << "to" << dead.fileName();
+
+    QMutexLocker lock(&mutex);
+    ++counters.deadLettered;
+    if (!dead.isOpen() &&
+        !dead.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Unbuffered)) {
+        qWarning() << "[TradeWriter] cannot open dead-letter file" << dead.fileName();
+        return;
+    }
+    QDataStream out(&dead);
+    out << e;
+}
@@ -0,0 +1,117 @@
+/* =========================================================================
+   TradeWriter.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Write‑behind persistence stage for "Trade_History".
+
+   Key features
+   • enqueue(TradeEvent) is callable from any thread and never touches the
+     database – order / tick latency no longer includes a Postgres round
+     trip.
+   • Runs on its own QThread on its own pooled connection
+     (DatabaseManager::connection()); events are grouped into one
+     transaction per batch:
+         INSERT … VALUES (…), (…), …                       – opens
+         UPDATE … FROM (VALUES (…), (…), …) AS v WHERE …   – closes
+   • Flushes on a size trigger (BATCH_ROWS queued) or a time trigger
+     (every FLUSH_MS), whichever comes first.
+   • A batch is written as a few fixed‑size statements (STATEMENT_ROWS:
+     500, 256, …, 2, 1 rows – the binary decomposition of its size), so
+     every statement text is one of a handful of DatabaseManager::prepared()
+     entries instead of one per batch size.
+   • Bounded backlog: past MAX_BACKLOG in memory, events are appended to an
+     on‑disk spill file and replayed in order once the database catches
+     up (also after a crash – a non‑empty spill is picked up on start).
+   • Flush latency (last / mean / max), rows written, failures, backlog
+     and spill counts are exposed through stats().
+
+   Design notes
+   • Order is preserved end to end: once spilling starts every new event
+     goes to disk until the file is fully replayed, and inside a batch the
+     INSERTs run before the UPDATEs, so a close never overtakes its open.
+   • A failed transaction is rolled back and probed: if the connection is
+     gone the rows go back to the front of the queue and the next timer
+     tick retries (reconnecting) for as long as it takes. A batch that
+     fails on a live connection is a data problem – it gets MAX_ATTEMPTS
+     tries, then is bisected so the good rows commit and each rejected
+     event is appended to the dead‑letter file (<spill>.dead, spill
+     format) and logged. One bad row can no longer wedge the writer.
+   • Only the first VALUES row of the UPDATE carries casts – Postgres types
+     the remaining rows from it. Statement text depends only on the row
+     count, so full BATCH_ROWS batches hit the prepared‑statement cache.
+   • stop() (blocking, from the owner) drains what it can and spills the
+     rest so nothing is lost on shutdown.
+   • Spill records carry the numeric TradeId – a spill left by a build with
+     string IDs must be drained by that build before upgrading.
+   ========================================================================= */
+
+#ifndef TRADEWRITER_H
+#define TRADEWRITER_H
+
+#include "tradeevent.h"
+
+#include <QObject>
+#include <QFile>
+#include <QList>
+#include <QMutex>
+#include <QTimer>
+
+#include <atomic>
+#include <deque>
+
+class TradeWriter : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int BATCH_ROWS  = 500;      // size trigger / rows per txn
+    static constexpr int FLUSH_MS    = 50;       // time trigger
+    static constexpr int MAX_BACKLOG = 100000;   // in‑memory events before spill
+    static constexpr int MAX_BATCHES = 8;        // txns per flush() call
+    static constexpr int MAX_ATTEMPTS = 3;       // data failures before bisecting
+
+    struct Stats {
+        quint64 written     = 0;
+        quint64 flushes     = 0;
+        quint64 failures    = 0;
+        quint64 spilled     = 0;
+        quint64 deadLettered = 0;
+        int     backlog     = 0;
+        double  lastFlushMs = 0.0;
+        double  meanFlushMs = 0.0;
+        double  maxFlushMs  = 0.0;
+    };
+
+    explicit TradeWriter(const QString &spillPath, QObject *parent = nullptr);
+
+    /* Any thread. */
+    void  enqueue(const TradeEvent &event);
+    Stats stats() const;
+
+public slots:
+    /* Writer thread: open the connection and arm the flush timer. */
+    void start();
+    void flush();
+    void stop();
+
+private:
+    enum class WriteResult { Ok, ConnectionLost, Rejected };
+
+    WriteResult writeBatch(const QList<TradeEvent> &batch);
+    WriteResult writeIsolating(const QList<TradeEvent> &batch, int &done);
+    void        deadLetter(const TradeEvent &event);
+    void spillLocked(const TradeEvent &event);
+    void loadSpillLocked();
+
+    mutable QMutex          mutex;          // guards queue / spill / stats
+    std::deque<TradeEvent>  queue;
+    QFile                   spill;
+    QFile                   dead;           // rejected events, spill format
+    int                     attempts     {0};   // data failures of the head batch
+    qint64                  spillReadPos {0};
+    bool                    spilling     {false};
+    Stats                   counters;
+    std::atomic<bool>       wakePending  {false};
+
+    QTimer                 *timer {nullptr};
+};
+
+#endif // TRADEWRITER_H
@@ -0,0 +1,73 @@
+/* =========================================================================
+   TriggerBook.cpp – implementation of TriggerBook.h
+   -------------------------------------------------------------------------
+   Sorted SL/TP ladders; see the header for the ladder layout.
+   ========================================================================= */
+
+#include "triggerbook.h"
+
+/* ------------------------------------------------------------------------
+   Arm both levels of a new position. Long: TP above, SL below. Short: the
+   reverse. Zero levels are left unarmed.
+   ------------------------------------------------------------------------ */
+void TriggerBook::add(int uid, Trade *t){
+    const bool isLong = t->isLong();
+    Ladder &ladder    = isLong ? longExits : shortExits;
+
+    const double upLevel   = isLong ? t->getTakeProfit() : t->getStopLoss();
+    const double downLevel = isLong ? t->getStopLoss()   : t->getTakeProfit();
+
+    const TradeId tid = t->getTradeID();
+    Handles h;
+    if (upLevel != 0.0) {
+        h.upLevels = &ladder.up;
+        h.up       = ladder.up.insert({ upLevel, { uid, tid } });
+    }
+    if (downLevel != 0.0) {
+        h.downLevels = &ladder.down;
+        h.down       = ladder.down.insert({ downLevel, { uid, tid } });
+    }
+    if (h.upLevels || h.downLevels)
+        handles.insert(tid, h);
+}
+
+void TriggerBook::remove(Trade *t){
+    remove(t->getTradeID());
+}
+
+void TriggerBook::remove(TradeId tid){
+    auto it = handles.find(tid);
+    if (it == handles.end()) return;
+
+    if (it->upLevels)   it->upLevels->erase(it->up);
+    if (it->downLevels) it->downLevels->erase(it->down);
+    handles.erase(it);
+}
+
+/* ------------------------------------------------------------------------
+   Gather crossed levels first, then disarm – erasing while walking a
+   range would invalidate the walk. remove() drops the twin level too, so
+   a trade whose SL and TP both fired is only reported once.
+   ------------------------------------------------------------------------ */
+QList<TriggerBook::Trigger> TriggerBook::collect(double px){
+    QList<Trigger> crossed;
+
+    for (Ladder *ladder : { &longExits, &shortExits }) {
+        for (auto it = ladder->up.begin();
+             it != ladder->up.end() && it->first <= px; ++it)
+            crossed << it->second;
+
+        for (auto it = ladder->down.lower_bound(px);
+             it != ladder->down.end(); ++it)
+            crossed << it->second;
+    }
+
+    QList<Trigger> hits;
+    hits.reserve(crossed.size());
+    for (const Trigger &tr : crossed) {
+        if (!handles.contains(tr.tradeID)) continue; // twin already popped
+        remove(tr.tradeID);
+        hits << tr;
+    }
+    return hits;
+}
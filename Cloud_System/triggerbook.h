@@ -0,0 +1,82 @@
+/* =========================================================================
+   TriggerBook.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Price‑indexed stop‑loss / take‑profit ladders for a single asset.
+
+   Key features
+   • Two ladders – longExits and shortExits – each split into the levels
+     that fire on an up‑move (long TP, short SL) and the levels that fire
+     on a down‑move (long SL, short TP).
+   • collect(px) pops only the levels the price has crossed, so a tick
+     costs O(log n + hits) instead of a walk over every open trade.
+   • remove(trade) is O(log n) thanks to iterators cached at insert time.
+
+   Design notes
+   • std::multimap keeps levels sorted, and its iterators stay valid across
+     unrelated inserts / erases – that is what lets remove() skip a search.
+   • A level of 0 means "unset" (see Trade.h) and is never armed.
+   • The book does not own Trade objects and hands back TradeIds, not
+     pointers: closing one hit can (through a direct connection, e.g. an
+     account lock → close‑all) delete the user's other trades while the
+     rest of collect()'s result is still being walked, so EngineShard
+     closes each hit through the checked closeTrade(userID, TradeId).
+     It removes an entry before it deletes the trade.
+   • Non‑copyable: cached iterators point into this instance's ladders, so
+     TradeServer keeps books in a std::map (QMap would copy on detach).
+   ========================================================================= */
+
+#ifndef TRIGGERBOOK_H
+#define TRIGGERBOOK_H
+
+#include "trade.h"
+
+#include <QHash>
+#include <QList>
+#include <map>
+
+class TriggerBook
+{
+public:
+    TriggerBook() = default;
+    TriggerBook(const TriggerBook&)            = delete;
+    TriggerBook& operator=(const TriggerBook&) = delete;
+
+    struct Trigger {
+        int     userID;
+        TradeId tradeID;
+    };
+
+    /* Arm SL/TP levels of @p trade (owned by @p userID). */
+    void add(int userID, Trade *trade);
+
+    /* Disarm @p trade; no‑op if it is not (or no longer) in the book. */
+    void remove(Trade *trade);
+    void remove(TradeId tradeID);
+
+    /* Pop every trade whose SL or TP has been crossed at price @p px.
+       Each trade appears at most once even if both levels fired. */
+    QList<Trigger> collect(double px);
+
+    int size() const { return handles.size(); }
+
+private:
+    using Levels = std::multimap<double, Trigger>;
+
+    struct Ladder {
+        Levels up;     // fires when px >= level
+        Levels down;   // fires when px <= level
+    };
+
+    struct Handles {
+        Levels           *upLevels   {nullptr};
+        Levels::iterator  up;
+        Levels           *downLevels {nullptr};
+        Levels::iterator  down;
+    };
+
+    Ladder                  longExits;    // up = TP, down = SL
+    Ladder                  shortExits;   // up = SL, down = TP
+    QHash<TradeId, Handles> handles;      // trade → armed levels
+};
+
+#endif // TRIGGERBOOK_H
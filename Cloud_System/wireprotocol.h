@@ -0,0 +1,336 @@
+/* =========================================================================
+   WireProtocol.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Versioned binary encoding for dashboard ↔ cloud traffic.
+
+   Key features
+   • Fixed‑layout little‑endian records sent as binary WebSocket frames;
+     numeric enums replace "position":"long"‑style strings.
+   • One schema shared by both builds: Cloud_System (TradeServer /
+     AccountServer) and the desktop client (WebSocketClient / Account).
+   • Negotiated per socket in the existing JSON handshake:
+         → { "connection": "tradeDashboard" | "account", "userID": …,
+             "protocol": "binary", "protocolVersion": 4 }
+         ← { "type": "protocol", "protocol": "binary", "protocolVersion": 4 }
+     No ack (older server) or a version mismatch means both ends stay on
+     compact JSON, which remains fully supported.
+
+   Frame layout
+       [u8 version][u8 Msg][u16 reserved = 0][payload …]
+   Payload primitives: u64 / i32 / u16 / u8 / f64 little‑endian, str = u16
+   length + UTF‑8 bytes.
+
+   Version history
+     1  string trade IDs
+     2  trade IDs are u64 TradeIds assigned by the cloud; NewTrade carries a
+        client‑chosen clientOrderID that OrderAck echoes back
+     3  TradeClosed carries the account's new balance – the account view
+        takes balance and alpha from the event instead of re‑reading
+        "Account", which the cloud now writes behind
+     4  TradeClosed carries the closed Trade_History row as well, so the
+        account view updates its history without reading the table the
+        cloud writes behind
+
+   Design notes
+   • Writer appends into one pre‑reserved QByteArray; Reader walks a
+     const char* range and latches ok=false on the first short read, so
+     callers check once at the end instead of after every field.
+   • Mirrored byte‑for‑byte in Cloud_System/ and trading_system_qt/Common/
+     services/ – keep the two copies in sync and bump VERSION on any
+     layout change.
+   ========================================================================= */
+
+#ifndef WIREPROTOCOL_H
+#define WIREPROTOCOL_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QtEndian>
+
+#include "tradeid.h"
+
+#include <cstring>
+
+namespace Wire {
+
+constexpr quint8 VERSION     = 4;
+constexpr int    HEADER_SIZE = 4;
+
+enum class Msg : quint8 {
+    /* dashboard → TradeServer */
+    NewTrade      = 1,
+    CloseTrade    = 2,
+    /* TradeServer → dashboard */
+    Positions     = 3,
+    Closed        = 4,
+    OrderAck      = 9,
+    Throttle      = 10,
+    /* AccountServer → account view */
+    Equity        = 5,
+    AlphaUpdated  = 6,
+    TradeClosed   = 7,
+    AccountLocked = 8,
+};
+
+enum class Side : quint8 { Long = 0, Short = 1 };
+
+inline Side    sideFromString(const QString &p) { return p == "long" ? Side::Long : Side::Short; }
+inline QString sideToString(Side s)             { return s == Side::Long ? QStringLiteral("long")
+                                                                         : QStringLiteral("short"); }
+
+/* ----------------------------- messages -------------------------------- */
+struct NewTrade {
+    qint32  userID        = 0;
+    quint64 clientOrderID = 0;        // echoed in OrderAck
+    qint32  asset      = 0;
+    Side    side       = Side::Long;
+    QString orderType;                // "market"
+    double  size       = 0.0;
+    double  stopLoss   = 0.0;
+    double  takeProfit = 0.0;
+    double  openPrice  = 0.0;
+};
+
+struct CloseTrade {
+    qint32  userID  = 0;
+    TradeId tradeID = 0;
+};
+
+struct Position {
+    TradeId tradeID    = 0;
+    Side    side       = Side::Long;
+    double  stopLoss   = 0.0;
+    double  takeProfit = 0.0;
+    double  size       = 0.0;
+    double  openPrice  = 0.0;
+    double  pnl        = 0.0;
+};
+
+struct Positions {
+    qint32          userID = 0;
+    qint32          asset  = 0;
+    QList<Position> trades;
+};
+
+struct Closed {
+    qint32  userID  = 0;
+    TradeId tradeID = 0;
+    double  pnl     = 0.0;
+};
+
+struct OrderAck {
+    qint32  userID        = 0;
+    quint64 clientOrderID = 0;
+    TradeId tradeID       = 0;        // 0 when rejected
+    bool    accepted      = false;
+    quint8  code     = 0;             // RiskVerdict on the cloud side
+    QString reason;                   // empty when accepted
+};
+
+struct Throttle {
+    qint32  userID   = 0;
+    qint32  queued   = 0;             // orders parked right now
+    qint32  rejected = 0;             // rate‑limited so far
+};
+
+/* AccountServer → account view: the Trade_History row of a close */
+struct TradeClosed {
+    double  balance    = 0.0;         // account balance after the close
+    TradeId tradeID    = 0;
+    qint32  asset      = 0;
+    double  size       = 0.0;
+    double  openPrice  = 0.0;
+    double  closePrice = 0.0;
+    double  pnl        = 0.0;
+    qint64  closedAtMs = 0;           // ms since epoch, UTC
+};
+
+/* ------------------------------ writer --------------------------------- */
+class Writer
+{
+public:
+    explicit Writer(Msg type, int reserve = 64){
+        buf.reserve(HEADER_SIZE + reserve);
+        u8(VERSION);
+        u8(static_cast<quint8>(type));
+        u16(0);
+    }
+
+    void u8 (quint8 v)  { buf.append(static_cast<char>(v)); }
+    void u16(quint16 v) { put(qToLittleEndian(v)); }
+    void i32(qint32 v)  { put(qToLittleEndian(v)); }
+    void u64(quint64 v) { put(qToLittleEndian(v)); }
+    void f64(double v)  { quint64 b; std::memcpy(&b, &v, 8); put(qToLittleEndian(b)); }
+    void str(const QString &s){
+        const QByteArray u = s.toUtf8();
+        u16(static_cast<quint16>(u.size()));
+        buf.append(u);
+    }
+
+    QByteArray take() { return std::move(buf); }
+
+private:
+    template <typename T> void put(T v) { buf.append(reinterpret_cast<const char*>(&v), sizeof v); }
+    QByteArray buf;
+};
+
+/* ------------------------------ reader --------------------------------- */
+class Reader
+{
+public:
+    explicit Reader(const QByteArray &frame)
+        : p(frame.constData()), end(frame.constData() + frame.size())
+    {
+        if (end - p < HEADER_SIZE) { ok = false; return; }
+        ver  = u8();
+        type = static_cast<Msg>(u8());
+        u16();
+        if (ver != VERSION) ok = false;
+    }
+
+    bool    good() const { return ok; }
+    Msg     msg()  const { return type; }
+
+    quint8  u8()  { return need(1) ? static_cast<quint8>(*p++) : 0; }
+    quint16 u16() { return get<quint16>(); }
+    qint32  i32() { return get<qint32>(); }
+    quint64 u64() { return get<quint64>(); }
+    double  f64() { quint64 b = get<quint64>(); double v; std::memcpy(&v, &b, 8); return v; }
+    QString str(){
+        const quint16 n = u16();
+        if (!need(n)) return QString();
+        const QString s = QString::fromUtf8(p, n);
+        p += n;
+        return s;
+    }
+
+private:
+    bool need(qint64 n){
+        if (ok && end - p >= n) return true;
+        ok = false;
+        return false;
+    }
+    template <typename T> T get(){
+        if (!need(sizeof(T))) return T(0);
+        T v;  std::memcpy(&v, p, sizeof v);  p += sizeof v;
+        return qFromLittleEndian(v);
+    }
+
+    const char *p;
+    const char *end;
+    bool        ok   {true};
+    quint8      ver  {0};
+    Msg         type {Msg::NewTrade};
+};
+
+/* ------------------------- encode / decode ----------------------------- */
+inline QByteArray encode(const NewTrade &m){
+    Writer w(Msg::NewTrade, 80);
+    w.i32(m.userID);  w.u64(m.clientOrderID);  w.i32(m.asset);
+    w.u8(static_cast<quint8>(m.side));   w.str(m.orderType);
+    w.f64(m.size);    w.f64(m.stopLoss); w.f64(m.takeProfit); w.f64(m.openPrice);
+    return w.take();
+}
+inline bool decode(Reader &r, NewTrade &m){
+    m.userID = r.i32();  m.clientOrderID = r.u64();  m.asset = r.i32();
+    m.side   = static_cast<Side>(r.u8());            m.orderType = r.str();
+    m.size   = r.f64();  m.stopLoss = r.f64(); m.takeProfit = r.f64(); m.openPrice = r.f64();
+    return r.good();
+}
+
+inline QByteArray encode(const CloseTrade &m){
+    Writer w(Msg::CloseTrade, 12);
+    w.i32(m.userID);  w.u64(m.tradeID);
+    return w.take();
+}
+inline bool decode(Reader &r, CloseTrade &m){
+    m.userID = r.i32();  m.tradeID = r.u64();
+    return r.good();
+}
+
+inline QByteArray encode(const Positions &m){
+    Writer w(Msg::Positions, 10 + m.trades.size() * 49);
+    w.i32(m.userID);  w.i32(m.asset);  w.u16(static_cast<quint16>(m.trades.size()));
+    for (const Position &p : m.trades) {
+        w.u64(p.tradeID);  w.u8(static_cast<quint8>(p.side));
+        w.f64(p.stopLoss); w.f64(p.takeProfit); w.f64(p.size);
+        w.f64(p.openPrice); w.f64(p.pnl);
+    }
+    return w.take();
+}
+inline bool decode(Reader &r, Positions &m){
+    m.userID = r.i32();  m.asset = r.i32();
+    const quint16 n = r.u16();
+    m.trades.clear();
+    m.trades.reserve(n);
+    for (quint16 i = 0; i < n && r.good(); ++i) {
+        Position p;
+        p.tradeID  = r.u64();  p.side = static_cast<Side>(r.u8());
+        p.stopLoss = r.f64();  p.takeProfit = r.f64(); p.size = r.f64();
+        p.openPrice = r.f64(); p.pnl = r.f64();
+        m.trades << p;
+    }
+    return r.good();
+}
+
+inline QByteArray encode(const Closed &m){
+    Writer w(Msg::Closed, 20);
+    w.i32(m.userID);  w.u64(m.tradeID);  w.f64(m.pnl);
+    return w.take();
+}
+inline bool decode(Reader &r, Closed &m){
+    m.userID = r.i32();  m.tradeID = r.u64();  m.pnl = r.f64();
+    return r.good();
+}
+
+inline QByteArray encode(const OrderAck &m){
+    Writer w(Msg::OrderAck, 48);
+    w.i32(m.userID);  w.u64(m.clientOrderID);  w.u64(m.tradeID);
+    w.u8(m.accepted ? 1 : 0);  w.u8(m.code);  w.str(m.reason);
+    return w.take();
+}
+inline bool decode(Reader &r, OrderAck &m){
+    m.userID   = r.i32();  m.clientOrderID = r.u64();  m.tradeID = r.u64();
+    m.accepted = r.u8() != 0;  m.code = r.u8();  m.reason = r.str();
+    return r.good();
+}
+
+inline QByteArray encode(const Throttle &m){
+    Writer w(Msg::Throttle, 12);
+    w.i32(m.userID);  w.i32(m.queued);  w.i32(m.rejected);
+    return w.take();
+}
+inline bool decode(Reader &r, Throttle &m){
+    m.userID = r.i32();  m.queued = r.i32();  m.rejected = r.i32();
+    return r.good();
+}
+
+inline QByteArray encode(const TradeClosed &m){
+    Writer w(Msg::TradeClosed, 60);
+    w.f64(m.balance);   w.u64(m.tradeID);    w.i32(m.asset);
+    w.f64(m.size);      w.f64(m.openPrice);  w.f64(m.closePrice);
+    w.f64(m.pnl);       w.u64(static_cast<quint64>(m.closedAtMs));
+    return w.take();
+}
+inline bool decode(Reader &r, TradeClosed &m){
+    m.balance = r.f64();  m.tradeID   = r.u64();  m.asset      = r.i32();
+    m.size    = r.f64();  m.openPrice = r.f64();  m.closePrice = r.f64();
+    m.pnl     = r.f64();  m.closedAtMs = static_cast<qint64>(r.u64());
+    return r.good();
+}
+
+/* Other AccountServer events: a bare header, optionally followed by one
+   f64 (Equity: equity, AlphaUpdated: alpha). */
+inline QByteArray encodeEvent(Msg type){
+    return Writer(type, 0).take();
+}
+inline QByteArray encodeEvent(Msg type, double value){
+    Writer w(type, 8);
+    w.f64(value);
+    return w.take();
+}
+
+} // namespace Wire
+
+#endif // WIREPROTOCOL_H
@@ -0,0 +1,27 @@
+QT = core
+QT += network
+QT += websockets
+
+CONFIG += c++17 cmdline
+CONFIG -= app_bundle
+
+TARGET = load_generator
+
+# WireProtocol / TradeId / RiskVerdict are shared with the cloud build.
+INCLUDEPATH += ../Cloud_System
+
+SOURCES += \
+        dashboardsession.cpp \
+        loadgenerator.cpp \
+        loadworker.cpp \
+        main.cpp
+
+HEADERS += \
+    ../Cloud_System/riskverdict.h \
+    ../Cloud_System/tradeid.h \
+    ../Cloud_System/wireprotocol.h \
+    dashboardsession.h \
+    loadconfig.h \
+    loadgenerator.h \
+    loadstats.h \
+    loadworker.h
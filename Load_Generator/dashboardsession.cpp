@@ -0,0 +1,236 @@
+/* =========================================================================
+   DashboardSession.cpp – implementation of DashboardSession.h
+   -------------------------------------------------------------------------
+   Handshakes, order / close traffic and latency stamping for one user.
+   ========================================================================= */
+
+#include "dashboardsession.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+DashboardSession::DashboardSession(int userID, const LoadConfig &cfg,
+                                   LoadStats *s, QObject *parent)
+    : QObject(parent),
+    uid(userID),
+    config(cfg),
+    stats(s)
+{
+    connect(&trade, &QWebSocket::connected,    this, &DashboardSession::onTradeConnected);
+    connect(&trade, &QWebSocket::disconnected, this, &DashboardSession::onTradeDisconnected);
+    connect(&trade, &QWebSocket::textMessageReceived,
+            this,   &DashboardSession::onTradeText);
+    connect(&trade, &QWebSocket::binaryMessageReceived,
+            this,   &DashboardSession::onTradeBinary);
+    connect(&trade, &QWebSocket::errorOccurred, this, &DashboardSession::onSocketError);
+
+    connect(&account, &QWebSocket::connected,    this, &DashboardSession::onAccountConnected);
+    connect(&account, &QWebSocket::disconnected, this, &DashboardSession::onAccountDisconnected);
+    connect(&account, &QWebSocket::textMessageReceived,   this, &DashboardSession::onAccountMessage);
+    connect(&account, &QWebSocket::binaryMessageReceived, this, &DashboardSession::onAccountMessage);
+    connect(&account, &QWebSocket::errorOccurred, this, &DashboardSession::onSocketError);
+}
+
+void DashboardSession::open(){
+    trade.open(config.tradeUrl());
+    if (config.account) account.open(config.accountUrl());
+}
+
+/* Same first message as WebSocketClient / Account on the desktop */
+void DashboardSession::handshake(QWebSocket &socket, const char *connection){
+    QJsonObject obj;
+    obj["connection"] = connection;
+    obj["userID"]     = uid;
+    if (config.binary) {
+        obj["protocol"]        = "binary";
+        obj["protocolVersion"] = Wire::VERSION;
+    }
+    socket.sendTextMessage(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+}
+
+void DashboardSession::onTradeConnected(){
+    tradeUp = true;
+    ++stats->tradeSockets;
+    handshake(trade, "tradeDashboard");
+}
+
+void DashboardSession::onAccountConnected(){
+    accountUp = true;
+    ++stats->accountSockets;
+    handshake(account, "account");
+}
+
+/* In‑flight state dies with the socket – the server forgets it too */
+void DashboardSession::onTradeDisconnected(){
+    if (!tradeUp) return;
+    tradeUp = false;
+    binary  = false;
+    --stats->tradeSockets;
+    ++stats->disconnects;
+    pendingOrders.clear();
+    unseenFills.clear();
+    openTrades.clear();
+    pendingCloses.clear();
+}
+
+void DashboardSession::onAccountDisconnected(){
+    if (!accountUp) return;
+    accountUp = false;
+    --stats->accountSockets;
+    ++stats->disconnects;
+}
+
+void DashboardSession::onSocketError(QAbstractSocket::SocketError){
+    ++stats->socketErrors;
+}
+
+/* ------------------------------ outbound ------------------------------- */
+void DashboardSession::placeOrder(int asset, Wire::Side side){
+    const quint64 orderID = ++lastOrderID;
+    pendingOrders.insert(orderID, monotonicNs());
+    ++stats->ordersSent;
+
+    if (binary) {
+        Wire::NewTrade m;
+        m.userID        = uid;
+        m.clientOrderID = orderID;
+        m.asset         = asset;
+        m.side          = side;
+        m.orderType     = "market";
+        m.size          = config.size;
+        trade.sendBinaryMessage(Wire::encode(m));
+        return;
+    }
+
+    QJsonObject obj;
+    obj["newTrade"]      = "newTrade";
+    obj["userID"]        = uid;
+    obj["clientOrderID"] = QString::number(orderID);
+    obj["stopLoss"]      = 0.0;
+    obj["takeProfit"]    = 0.0;
+    obj["size"]          = config.size;
+    obj["asset"]         = asset;
+    obj["openPrice"]     = 0.0;
+    obj["type"]          = "market";
+    obj["position"]      = Wire::sideToString(side);
+    trade.sendTextMessage(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+}
+
+bool DashboardSession::closeTrade(TradeId tid){
+    if (!tradeUp || !openTrades.contains(tid) || pendingCloses.contains(tid))
+        return false;
+    pendingCloses.insert(tid, monotonicNs());
+    ++stats->closesSent;
+
+    if (binary) {
+        trade.sendBinaryMessage(Wire::encode(Wire::CloseTrade{ uid, tid }));
+        return true;
+    }
+    QJsonObject obj;
+    obj["closeTrade"] = "closeTrade";
+    obj["userID"]     = uid;
+    obj["tradeID"]    = TradeIds::toString(tid);
+    trade.sendTextMessage(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+    return true;
+}
+
+/* ------------------------------ inbound -------------------------------- */
+void DashboardSession::onAck(quint64 orderID, TradeId tid, bool accepted,
+                             bool rateLimited){
+    const auto sent = pendingOrders.constFind(orderID);
+    if (sent == pendingOrders.cend()) return;
+    const qint64 now = monotonicNs();
+    stats->ackLatency.record(now - sent.value());
+    ++stats->acks;
+
+    if (accepted) {
+        ++stats->accepted;
+        openTrades.insert(tid);
+        unseenFills.insert(tid, sent.value());
+        emit filled(this, tid);
+    } else {
+        ++stats->rejected;
+        if (rateLimited) ++stats->rateLimited;
+    }
+    pendingOrders.erase(sent);
+}
+
+void DashboardSession::onPosition(TradeId tid){
+    const auto sent = unseenFills.constFind(tid);
+    if (sent == unseenFills.cend()) return;
+    stats->positionLatency.record(monotonicNs() - sent.value());
+    unseenFills.erase(sent);
+}
+
+void DashboardSession::onClosed(TradeId tid){
+    openTrades.remove(tid);
+    unseenFills.remove(tid);
+    const auto sent = pendingCloses.constFind(tid);
+    if (sent == pendingCloses.cend()) return;          // SL / TP or foreign close
+    stats->closeLatency.record(monotonicNs() - sent.value());
+    ++stats->closed;
+    pendingCloses.erase(sent);
+}
+
+void DashboardSession::onTradeText(const QString &message){
+    const QJsonObject obj  = QJsonDocument::fromJson(message.toUtf8()).object();
+    const QString     type = obj.value("type").toString();
+
+    if (type == "protocol") {
+        binary = obj.value("protocol").toString() == "binary" &&
+                 obj.value("protocolVersion").toInt() == Wire::VERSION;
+    } else if (type == "orderAck") {
+        onAck(obj.value("clientOrderID").toString().toULongLong(),
+              TradeIds::fromString(obj.value("tradeID").toString()),
+              obj.value("accepted").toBool(),
+              obj.value("code").toInt() == int(RiskVerdict::RateLimited));
+    } else if (type == "positions") {
+        ++stats->positionFrames;
+        if (unseenFills.isEmpty()) return;
+        for (const QJsonValue &v : obj.value("trades").toArray())
+            onPosition(TradeIds::fromString(v.toObject().value("tradeID").toString()));
+    } else if (type == "closed") {
+        onClosed(TradeIds::fromString(obj.value("tradeID").toString()));
+    } else if (type == "throttle") {
+        ++stats->throttleFrames;
+    }
+}
+
+void DashboardSession::onTradeBinary(const QByteArray &frame){
+    Wire::Reader r(frame);
+    if (!r.good()) return;
+
+    switch (r.msg()) {
+    case Wire::Msg::OrderAck: {
+        Wire::OrderAck m;
+        if (Wire::decode(r, m))
+            onAck(m.clientOrderID, m.tradeID, m.accepted,
+                  RiskVerdict(m.code) == RiskVerdict::RateLimited);
+        break;
+    }
+    case Wire::Msg::Positions: {
+        ++stats->positionFrames;
+        if (unseenFills.isEmpty()) break;
+        Wire::Positions m;
+        if (!Wire::decode(r, m)) break;
+        for (const Wire::Position &p : std::as_const(m.trades)) onPosition(p.tradeID);
+        break;
+    }
+    case Wire::Msg::Closed: {
+        Wire::Closed m;
+        if (Wire::decode(r, m)) onClosed(m.tradeID);
+        break;
+    }
+    case Wire::Msg::Throttle:
+        ++stats->throttleFrames;
+        break;
+    default:
+        break;
+    }
+}
+
+/* Equity / alpha / tradeClosed pushes – counted, not decoded */
+void DashboardSession::onAccountMessage(){
+    ++stats->accountEvents;
+}
@@ -0,0 +1,95 @@
+/* =========================================================================
+   DashboardSession.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   One simulated trader: the two sockets a desktop client keeps open.
+
+   Key features
+   • Trade socket to TradeServer with the client's own handshake
+         { "connection": "tradeDashboard", "userID": …,
+           "protocol": "binary", "protocolVersion": Wire::VERSION }
+     and an optional account socket to AccountServer ("account").
+   • Orders and closes go out exactly as WebSocketClient sends them –
+     JSON until the server acks the binary protocol, WireProtocol frames
+     after – so the server pays the real decode cost.
+   • Latencies are stamped on the worker thread with one monotonic clock:
+         ack       newTrade sent → orderAck
+         position  newTrade sent → first "positions" frame with the trade
+         close     closeTrade sent → "closed" frame
+   • Accepted fills are reported through filled() so the worker can
+     close them after $LOAD_HOLD_MS.
+
+   Design notes
+   • Lives on its LoadWorker's thread and writes straight into that
+     worker's LoadStats – no locks, no signals on the hot path.
+   • "positions" frames only follow price ticks, so position latency
+     includes the wait for the next tick of the asset (run the cloud
+     against Mock_Exchange with a known $MOCK_TICK_HZ for stable numbers).
+   ========================================================================= */
+
+#ifndef DASHBOARDSESSION_H
+#define DASHBOARDSESSION_H
+
+#include "loadconfig.h"
+#include "loadstats.h"
+#include "riskverdict.h"
+#include "wireprotocol.h"
+
+#include <QAbstractSocket>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QWebSocket>
+
+class DashboardSession : public QObject
+{
+    Q_OBJECT
+public:
+    DashboardSession(int userID, const LoadConfig &config, LoadStats *stats,
+                     QObject *parent = nullptr);
+
+    void open();
+    int  userID() const { return uid; }
+    bool ready()  const { return tradeUp; }
+
+    /* Open trades plus orders still waiting for their ack */
+    int  exposure() const { return int(openTrades.size() + pendingOrders.size()); }
+
+    void placeOrder(int asset, Wire::Side side);
+    bool closeTrade(TradeId tradeID);        // false if already gone
+
+signals:
+    void filled(DashboardSession *session, TradeId tradeID);
+
+private slots:
+    void onTradeConnected();
+    void onAccountConnected();
+    void onTradeText(const QString &message);
+    void onTradeBinary(const QByteArray &frame);
+    void onAccountMessage();
+    void onTradeDisconnected();
+    void onAccountDisconnected();
+    void onSocketError(QAbstractSocket::SocketError error);
+
+private:
+    void handshake(QWebSocket &socket, const char *connection);
+    void onAck(quint64 clientOrderID, TradeId tradeID, bool accepted,
+               bool rateLimited);
+    void onPosition(TradeId tradeID);
+    void onClosed(TradeId tradeID);
+
+    int                     uid;
+    const LoadConfig       &config;
+    LoadStats              *stats;
+    QWebSocket              trade;
+    QWebSocket              account;
+    bool                    tradeUp   {false};
+    bool                    accountUp {false};
+    bool                    binary    {false};   // server acked the protocol
+    quint64                 lastOrderID {0};
+    QHash<quint64, qint64>  pendingOrders;       // clientOrderID → sent ns
+    QHash<TradeId, qint64>  unseenFills;         // accepted, no positions frame yet
+    QSet<TradeId>           openTrades;
+    QHash<TradeId, qint64>  pendingCloses;       // closeTrade sent ns
+};
+
+#endif // DASHBOARDSESSION_H
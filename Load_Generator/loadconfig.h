@@ -0,0 +1,103 @@
+/* =========================================================================
+   LoadConfig.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Load‑generator settings, read from the environment like the servers'.
+
+     LOAD_HOST            cloud host                        (localhost)
+     LOAD_TRADE_PORT      TradeServer port                  (12345)
+     LOAD_ACCOUNT_PORT    AccountServer port                (12346)
+     LOAD_USER_BASE       first userID; users are consecutive (1)
+     LOAD_STEPS           connected users per step, "100,500,1000"
+                          (default: $LOAD_USERS, itself default 100)
+     LOAD_STEP_S          measured seconds per step         (30)
+     LOAD_WARMUP_S        unmeasured seconds after a ramp   (5)
+     LOAD_CONNECT_RATE    new sessions per second           (500)
+     LOAD_THREADS         socket worker threads             (ideal count)
+     LOAD_ORDER_RATE      orders / s per user               (0.5)
+     LOAD_HOLD_MS         close each fill after this long   (3000, 0 = never)
+     LOAD_MAX_OPEN        open + in‑flight orders per user  (5)
+     LOAD_ASSETS          assets 0 … n‑1 picked at random   (4)
+     LOAD_SIZE            order size                        (0.001)
+     LOAD_ACCOUNT         also open the "account" socket    (1)
+     LOAD_OUT             JSON report path                  (load_report.json)
+     WIRE_PROTOCOL        "json" to stay on JSON, else binary (as the client)
+   ========================================================================= */
+
+#ifndef LOADCONFIG_H
+#define LOADCONFIG_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QUrl>
+
+#include <algorithm>
+
+struct LoadConfig {
+    QString    host         = "localhost";
+    quint16    tradePort    = 12345;
+    quint16    accountPort  = 12346;
+    int        userBase     = 1;
+    QList<int> steps        { 100 };
+    int        stepSeconds  = 30;
+    int        warmupSeconds = 5;
+    int        connectRate  = 500;
+    int        threads      = 1;
+    double     orderRate    = 0.5;
+    int        holdMs       = 3000;
+    int        maxOpen      = 5;
+    int        assets       = 4;
+    double     size         = 0.001;
+    bool       account      = true;
+    bool       binary       = true;
+    QString    reportPath   = "load_report.json";
+
+    QUrl tradeUrl()   const { return QUrl(QString("ws://%1:%2").arg(host).arg(tradePort)); }
+    QUrl accountUrl() const { return QUrl(QString("ws://%1:%2").arg(host).arg(accountPort)); }
+
+    static LoadConfig fromEnvironment(){
+        LoadConfig c;
+        auto intVar = [](const char *name, int fallback, int min) {
+            bool ok = false;
+            const int v = qEnvironmentVariableIntValue(name, &ok);
+            return (ok && v >= min) ? v : fallback;
+        };
+        auto doubleVar = [](const char *name, double fallback) {
+            bool ok = false;
+            const double v = qEnvironmentVariable(name).toDouble(&ok);
+            return (ok && v >= 0) ? v : fallback;
+        };
+
+        c.host          = qEnvironmentVariable("LOAD_HOST", c.host);
+        c.tradePort     = quint16(intVar("LOAD_TRADE_PORT",   c.tradePort, 1));
+        c.accountPort   = quint16(intVar("LOAD_ACCOUNT_PORT", c.accountPort, 1));
+        c.userBase      = intVar("LOAD_USER_BASE",    c.userBase, 0);
+        c.stepSeconds   = intVar("LOAD_STEP_S",       c.stepSeconds, 1);
+        c.warmupSeconds = intVar("LOAD_WARMUP_S",     c.warmupSeconds, 0);
+        c.connectRate   = intVar("LOAD_CONNECT_RATE", c.connectRate, 1);
+        c.threads       = intVar("LOAD_THREADS",      qMax(1, QThread::idealThreadCount()), 1);
+        c.holdMs        = intVar("LOAD_HOLD_MS",      c.holdMs, 0);
+        c.maxOpen       = intVar("LOAD_MAX_OPEN",     c.maxOpen, 1);
+        c.assets        = intVar("LOAD_ASSETS",       c.assets, 1);
+        c.account       = intVar("LOAD_ACCOUNT",      1, 0) != 0;
+        c.orderRate     = doubleVar("LOAD_ORDER_RATE", c.orderRate);
+        c.size          = doubleVar("LOAD_SIZE",       c.size);
+        c.binary        = qEnvironmentVariable("WIRE_PROTOCOL") != "json";
+        c.reportPath    = qEnvironmentVariable("LOAD_OUT", c.reportPath);
+
+        const QString steps = qEnvironmentVariable("LOAD_STEPS",
+                                  QString::number(intVar("LOAD_USERS", 100, 1)));
+        c.steps.clear();
+        for (const QString &s : steps.split(',', Qt::SkipEmptyParts)) {
+            bool ok = false;
+            const int n = s.trimmed().toInt(&ok);
+            if (ok && n > 0) c.steps << n;
+        }
+        if (c.steps.isEmpty()) c.steps << 100;
+        std::sort(c.steps.begin(), c.steps.end());
+        return c;
+    }
+};
+
+#endif // LOADCONFIG_H
@@ -0,0 +1,239 @@
+/* =========================================================================
+   LoadGenerator.cpp – implementation of LoadGenerator.h
+   -------------------------------------------------------------------------
+   Step state machine: ramp → warm‑up → measure → row, then the report.
+   ========================================================================= */
+
+#include "loadgenerator.h"
+
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QtDebug>
+
+namespace {
+
+const std::vector<double> PERCENTILES { 50.0, 90.0, 99.0, 99.9, 100.0 };
+const char *const         PCT_KEYS[]  { "p50", "p90", "p99", "p999", "max" };
+
+QJsonObject latencyJson(const LatencyRecorder &r){
+    QJsonObject o;
+    o["samples"] = qint64(r.count());
+    const std::vector<double> us = r.percentilesUs(PERCENTILES);
+    for (std::size_t i = 0; i < us.size(); ++i) o[PCT_KEYS[i]] = us[i];
+    return o;
+}
+
+} // namespace
+
+LoadGenerator::LoadGenerator(const LoadConfig &cfg, QObject *parent)
+    : QObject(parent),
+    config(cfg)
+{
+    for (int i = 0; i < config.threads; ++i) {
+        auto *t = new QThread(this);
+        auto *w = new LoadWorker(i, config);
+        t->setObjectName(QString("load-%1").arg(i));
+        w->moveToThread(t);
+        connect(t, &QThread::started,  w, &LoadWorker::start);
+        connect(t, &QThread::finished, w, &QObject::deleteLater);
+        threads << t;
+        workers << w;
+    }
+    connect(&rampTimer, &QTimer::timeout, this, &LoadGenerator::pollRamp);
+}
+
+LoadGenerator::~LoadGenerator(){
+    for (QThread *t : std::as_const(threads)) {
+        t->quit();
+        t->wait();
+    }
+}
+
+void LoadGenerator::start(){
+    qDebug() << "[LoadGenerator]" << config.tradeUrl().toString()
+             << (config.account ? config.accountUrl().toString() : QString("(no account)"))
+             << "steps" << config.steps << "threads" << config.threads
+             << (config.binary ? "binary" : "json")
+             << "orders/s/user" << config.orderRate << "hold ms" << config.holdMs;
+    for (QThread *t : std::as_const(threads)) t->start();
+    beginStep();
+}
+
+/* -------------------------------- phases -------------------------------- */
+void LoadGenerator::beginStep(){
+    if (++step >= config.steps.size()) { finish(); return; }
+
+    const int target = config.steps[step];
+    QList<QList<int>> share(workers.size());
+    for (int n = users; n < target; ++n)
+        share[n % workers.size()] << config.userBase + n;
+    for (int i = 0; i < workers.size(); ++i) {
+        if (share[i].isEmpty()) continue;
+        const QList<int> ids = share[i];
+        LoadWorker *w = workers[i];
+        QMetaObject::invokeMethod(w, [w, ids]() { w->addUsers(ids); });
+    }
+
+    const int added = target - users;
+    users       = target;
+    rampLimitMs = qint64(added) * 2000 / config.connectRate + 10000;
+    phaseClock.start();
+    qDebug() << "[LoadGenerator] step" << step + 1 << "–" << target << "users, ramping"
+             << added;
+    rampTimer.start(250);
+}
+
+void LoadGenerator::pollRamp(){
+    const int up = connectedSessions();
+    const bool done = openingSessions() == 0 && up >= users;
+    if (!done && phaseClock.elapsed() < rampLimitMs) return;
+
+    rampTimer.stop();
+    if (!done)
+        qWarning() << "[LoadGenerator] ramp timed out:" << up << "of" << users
+                   << "trade sockets up";
+    beginWarmup();
+}
+
+void LoadGenerator::beginWarmup(){
+    for (LoadWorker *w : std::as_const(workers))
+        QMetaObject::invokeMethod(w, [w]() { w->setTrading(true); });
+    QTimer::singleShot(config.warmupSeconds * 1000, this, &LoadGenerator::beginMeasure);
+}
+
+void LoadGenerator::beginMeasure(){
+    collect();                                  // drop ramp / warm‑up samples
+    phaseClock.start();
+    QTimer::singleShot(config.stepSeconds * 1000, this, &LoadGenerator::endMeasure);
+}
+
+void LoadGenerator::endMeasure(){
+    const LoadStats stats   = collect();
+    const double    seconds = phaseClock.elapsed() / 1000.0;
+    const QJsonObject r = row(stats, seconds);
+    rows << r;
+    print(r);
+    beginStep();
+}
+
+void LoadGenerator::finish(){
+    for (LoadWorker *w : std::as_const(workers))
+        QMetaObject::invokeMethod(w, [w]() { w->setTrading(false); });
+
+    QJsonObject cfg;
+    cfg["host"]          = config.host;
+    cfg["tradePort"]     = config.tradePort;
+    cfg["accountPort"]   = config.accountPort;
+    cfg["protocol"]      = config.binary ? "binary" : "json";
+    cfg["threads"]       = config.threads;
+    cfg["orderRate"]     = config.orderRate;
+    cfg["holdMs"]        = config.holdMs;
+    cfg["maxOpen"]       = config.maxOpen;
+    cfg["assets"]        = config.assets;
+    cfg["stepSeconds"]   = config.stepSeconds;
+    cfg["warmupSeconds"] = config.warmupSeconds;
+    cfg["account"]       = config.account;
+
+    QJsonObject report;
+    report["generatedAt"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    report["config"]      = cfg;
+    report["steps"]       = rows;
+
+    QSaveFile f(config.reportPath);
+    if (f.open(QIODevice::WriteOnly) &&
+        f.write(QJsonDocument(report).toJson()) >= 0 && f.commit())
+        qDebug() << "[LoadGenerator] report written to" << config.reportPath;
+    else
+        qWarning() << "[LoadGenerator] cannot write" << config.reportPath << f.errorString();
+
+    emit finished();
+}
+
+/* ------------------------------ collection ------------------------------ */
+LoadStats LoadGenerator::collect(){
+    LoadStats total;
+    for (LoadWorker *w : std::as_const(workers)) {
+        LoadStats s;
+        QMetaObject::invokeMethod(w, [w, &s]() { s = w->takeWindow(); },
+                                  Qt::BlockingQueuedConnection);
+        total.merge(s);
+    }
+    return total;
+}
+
+int LoadGenerator::connectedSessions(){
+    int n = 0;
+    for (LoadWorker *w : std::as_const(workers)) {
+        int c = 0;
+        QMetaObject::invokeMethod(w, [w, &c]() { c = w->connected(); },
+                                  Qt::BlockingQueuedConnection);
+        n += c;
+    }
+    return n;
+}
+
+int LoadGenerator::openingSessions(){
+    int n = 0;
+    for (LoadWorker *w : std::as_const(workers)) {
+        int c = 0;
+        QMetaObject::invokeMethod(w, [w, &c]() { c = w->opening(); },
+                                  Qt::BlockingQueuedConnection);
+        n += c;
+    }
+    return n;
+}
+
+QJsonObject LoadGenerator::row(const LoadStats &s, double seconds) const{
+    const double secs = qMax(seconds, 1e-3);
+    QJsonObject r;
+    r["users"]            = users;
+    r["seconds"]          = seconds;
+    r["tradeSockets"]     = s.tradeSockets;
+    r["accountSockets"]   = s.accountSockets;
+    r["offeredOrdersPerS"] = users * config.orderRate;
+    r["ordersSent"]       = qint64(s.ordersSent);
+    r["ordersSkipped"]    = qint64(s.ordersSkipped);
+    r["acks"]             = qint64(s.acks);
+    r["acksPerS"]         = s.acks / secs;
+    r["accepted"]         = qint64(s.accepted);
+    r["rejected"]         = qint64(s.rejected);
+    r["rateLimited"]      = qint64(s.rateLimited);
+    r["closesSent"]       = qint64(s.closesSent);
+    r["closed"]           = qint64(s.closed);
+    r["positionFramesPerS"] = s.positionFrames / secs;
+    r["accountEventsPerS"]  = s.accountEvents / secs;
+    r["throttleFrames"]   = qint64(s.throttleFrames);
+    r["disconnects"]      = qint64(s.disconnects);
+    r["socketErrors"]     = qint64(s.socketErrors);
+    r["ackUs"]            = latencyJson(s.ackLatency);
+    r["positionUs"]       = latencyJson(s.positionLatency);
+    r["closeUs"]          = latencyJson(s.closeLatency);
+    return r;
+}
+
+void LoadGenerator::print(const QJsonObject &r) const{
+    QTextStream out(stdout);
+    auto lat = [&](const char *name, const QJsonObject &o) {
+        out << "    " << qSetFieldWidth(9) << Qt::left << name << qSetFieldWidth(0)
+            << " p50 " << o["p50"].toDouble() << "  p90 " << o["p90"].toDouble()
+            << "  p99 " << o["p99"].toDouble() << "  p99.9 " << o["p999"].toDouble()
+            << "  max " << o["max"].toDouble() << " us  (" << o["samples"].toInteger()
+            << ")\n";
+    };
+    out << "users " << r["users"].toInt()
+        << "  sockets " << r["tradeSockets"].toInt() << "/" << r["accountSockets"].toInt()
+        << "  orders/s offered " << r["offeredOrdersPerS"].toDouble()
+        << " acked " << r["acksPerS"].toDouble()
+        << "  accepted " << r["accepted"].toInteger()
+        << " rejected " << r["rejected"].toInteger()
+        << " (rate-limited " << r["rateLimited"].toInteger() << ")"
+        << "  positions/s " << r["positionFramesPerS"].toDouble()
+        << "  disconnects " << r["disconnects"].toInteger() << "\n";
+    lat("ack",      r["ackUs"].toObject());
+    lat("position", r["positionUs"].toObject());
+    lat("close",    r["closeUs"].toObject());
+    out.flush();
+}
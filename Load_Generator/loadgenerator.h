@@ -0,0 +1,81 @@
+/* =========================================================================
+   LoadGenerator.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Capacity‑curve driver: how many traders can one cloud node carry?
+
+   Key features
+   • Walks $LOAD_STEPS (e.g. 100,500,1000,2000 users). Each step ramps the
+     extra sessions in, trades unmeasured for $LOAD_WARMUP_S, then
+     measures $LOAD_STEP_S and records one row:
+       – connected trade / account sockets
+       – offered vs. acked order rate, accepted / rejected / rate‑limited
+       – ack, position‑update and close latency p50 / p90 / p99 / p99.9 /
+         max (µs)
+       – push rates ("positions" frames, account events), disconnects
+   • Rows are printed as they finish and the whole curve is written to
+     $LOAD_OUT as JSON (config + steps), so releases can be diffed.
+
+   Design notes
+   • Sessions are spread round‑robin over $LOAD_THREADS LoadWorkers, each
+     on its own QThread; the controller only talks to them through
+     invokeMethod, so its own thread stays idle and does not skew timing.
+   • A ramp gives up after twice its nominal duration plus 10 s – the row
+     is still recorded, with the socket counts showing the shortfall.
+   • The users must exist in the cloud's account table; unknown IDs come
+     back as "unknown account" rejects and show up in the rejected column.
+   ========================================================================= */
+
+#ifndef LOADGENERATOR_H
+#define LOADGENERATOR_H
+
+#include "loadconfig.h"
+#include "loadstats.h"
+#include "loadworker.h"
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QList>
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+
+class LoadGenerator : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LoadGenerator(const LoadConfig &config, QObject *parent = nullptr);
+    ~LoadGenerator();
+
+    void start();
+
+signals:
+    void finished();
+
+private slots:
+    void pollRamp();
+
+private:
+    void beginStep();
+    void beginWarmup();
+    void beginMeasure();
+    void endMeasure();
+    void finish();
+
+    LoadStats collect();
+    int       connectedSessions();
+    int       openingSessions();
+    QJsonObject row(const LoadStats &stats, double seconds) const;
+    void      print(const QJsonObject &row) const;
+
+    LoadConfig           config;
+    QList<QThread*>      threads;
+    QList<LoadWorker*>   workers;
+    QTimer               rampTimer;
+    QElapsedTimer        phaseClock;
+    int                  step      {-1};
+    int                  users     {0};         // sessions handed out so far
+    qint64               rampLimitMs {0};
+    QJsonArray           rows;
+};
+
+#endif // LOADGENERATOR_H
@@ -0,0 +1,117 @@
+/* =========================================================================
+   LoadStats.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Counters and latency samples collected by the load generator.
+
+   Key features
+   • LatencyRecorder keeps raw nanosecond samples; percentile() sorts a
+     copy once per report, so p99.9 and max are exact, not bucketed.
+   • LoadStats is one worker's view of a measurement window – counters
+     plus three recorders (order → ack, order → first "positions" frame
+     carrying the trade, close → "closed" frame). merge() folds the
+     workers together at the end of a step.
+
+   Design notes
+   • Owned by exactly one LoadWorker thread while it is filled; handed to
+     the controller by value, so no locking anywhere.
+   • Samples are bounded by the run (orders × steps); a 1000‑user, 0.5 /s,
+     60 s step is 30 k samples per recorder – small next to the sockets.
+   ========================================================================= */
+
+#ifndef LOADSTATS_H
+#define LOADSTATS_H
+
+#include <QDeadlineTimer>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <vector>
+
+class LatencyRecorder
+{
+public:
+    void record(qint64 ns) { samples.push_back(ns); }
+    void merge(const LatencyRecorder &o){
+        samples.insert(samples.end(), o.samples.begin(), o.samples.end());
+    }
+    void clear() { samples.clear(); }
+
+    qsizetype count() const { return qsizetype(samples.size()); }
+
+    /* p in [0, 100]; 0 when empty. Values in microseconds. */
+    std::vector<double> percentilesUs(const std::vector<double> &ps) const{
+        std::vector<double> out(ps.size(), 0.0);
+        if (samples.empty()) return out;
+        std::vector<qint64> sorted(samples);
+        std::sort(sorted.begin(), sorted.end());
+        for (std::size_t i = 0; i < ps.size(); ++i) {
+            const double rank = ps[i] / 100.0 * double(sorted.size() - 1);
+            out[i] = sorted[std::size_t(rank + 0.5)] / 1000.0;
+        }
+        return out;
+    }
+
+private:
+    std::vector<qint64> samples;
+};
+
+struct LoadStats {
+    /* sessions */
+    int     tradeSockets   = 0;     // connected right now
+    int     accountSockets = 0;
+    quint64 disconnects    = 0;
+    quint64 socketErrors   = 0;
+
+    /* order flow */
+    quint64 ordersSent     = 0;
+    quint64 ordersSkipped  = 0;     // user at $LOAD_MAX_OPEN
+    quint64 acks           = 0;
+    quint64 accepted       = 0;
+    quint64 rejected       = 0;
+    quint64 rateLimited    = 0;     // subset of rejected
+    quint64 closesSent     = 0;
+    quint64 closed         = 0;
+
+    /* pushes */
+    quint64 positionFrames = 0;
+    quint64 throttleFrames = 0;
+    quint64 accountEvents  = 0;
+
+    LatencyRecorder ackLatency;
+    LatencyRecorder positionLatency;
+    LatencyRecorder closeLatency;
+
+    void merge(const LoadStats &o){
+        tradeSockets   += o.tradeSockets;
+        accountSockets += o.accountSockets;
+        disconnects    += o.disconnects;
+        socketErrors   += o.socketErrors;
+        ordersSent     += o.ordersSent;
+        ordersSkipped  += o.ordersSkipped;
+        acks           += o.acks;
+        accepted       += o.accepted;
+        rejected       += o.rejected;
+        rateLimited    += o.rateLimited;
+        closesSent     += o.closesSent;
+        closed         += o.closed;
+        positionFrames += o.positionFrames;
+        throttleFrames += o.throttleFrames;
+        accountEvents  += o.accountEvents;
+        ackLatency.merge(o.ackLatency);
+        positionLatency.merge(o.positionLatency);
+        closeLatency.merge(o.closeLatency);
+    }
+
+    /* Start a new window; socket gauges carry over. */
+    void resetWindow(){
+        const int trade = tradeSockets, account = accountSockets;
+        *this = LoadStats();
+        tradeSockets   = trade;
+        accountSockets = account;
+    }
+};
+
+/* Monotonic clock shared by every session and worker */
+inline qint64 monotonicNs(){ return QDeadlineTimer::current().deadlineNSecs(); }
+
+#endif // LOADSTATS_H
@@ -0,0 +1,101 @@
+/* =========================================================================
+   LoadWorker.cpp – implementation of LoadWorker.h
+   -------------------------------------------------------------------------
+   Connection ramp, order budget and timed closes for one thread's users.
+   ========================================================================= */
+
+#include "loadworker.h"
+
+LoadWorker::LoadWorker(int index, const LoadConfig &cfg, QObject *parent)
+    : QObject(parent),
+    workerIndex(index),
+    config(cfg),
+    rng(std::mt19937::result_type(0x5eed + index))
+{
+    tick.setTimerType(Qt::PreciseTimer);
+    connect(&tick, &QTimer::timeout, this, &LoadWorker::onTick);
+}
+
+void LoadWorker::start(){
+    lastTickNs = monotonicNs();
+    tick.start(TICK_MS);
+}
+
+void LoadWorker::addUsers(const QList<int> &userIDs){
+    connectQueue << userIDs;
+}
+
+LoadStats LoadWorker::takeWindow(){
+    LoadStats window = stats;
+    stats.resetWindow();
+    return window;
+}
+
+void LoadWorker::onTick(){
+    const qint64 now     = monotonicNs();
+    const double seconds = (now - lastTickNs) / 1e9;
+    lastTickNs = now;
+
+    openSessions(seconds);
+    if (!trading) return;
+    closeDue(now);
+    placeOrders(seconds);
+}
+
+/* This worker's share of $LOAD_CONNECT_RATE */
+void LoadWorker::openSessions(double seconds){
+    if (connectQueue.isEmpty()) { connectCredit = 0.0; return; }
+    connectCredit += seconds * config.connectRate / qMax(1, config.threads);
+    while (connectCredit >= 1.0 && !connectQueue.isEmpty()) {
+        auto *s = new DashboardSession(connectQueue.takeFirst(), config, &stats, this);
+        connect(s, &DashboardSession::filled, this, &LoadWorker::onFilled);
+        sessions << s;
+        s->open();
+        connectCredit -= 1.0;
+    }
+}
+
+/* ------------------------------------------------------------------------
+   Spend the order budget round‑robin. A user at $LOAD_MAX_OPEN uses up
+   its turn (counted as skipped) so the offered rate stays honest; users
+   whose socket is not up yet are passed over without cost.
+   ------------------------------------------------------------------------ */
+void LoadWorker::placeOrders(double seconds){
+    if (sessions.isEmpty() || config.orderRate <= 0) return;
+
+    int ready = 0;
+    for (const DashboardSession *s : std::as_const(sessions))
+        if (s->ready()) ++ready;
+    if (ready == 0) return;
+
+    orderCredit += config.orderRate * ready * seconds;
+    std::uniform_int_distribution<int> asset(0, config.assets - 1);
+    std::bernoulli_distribution        isLong(0.5);
+
+    int scanned = 0;
+    while (orderCredit >= 1.0 && scanned < sessions.size()) {
+        DashboardSession *s = sessions[cursor];
+        cursor = (cursor + 1) % int(sessions.size());
+        if (!s->ready()) { ++scanned; continue; }
+        scanned = 0;
+        orderCredit -= 1.0;
+        if (s->exposure() >= config.maxOpen) {
+            ++stats.ordersSkipped;
+            continue;
+        }
+        s->placeOrder(asset(rng), isLong(rng) ? Wire::Side::Long : Wire::Side::Short);
+    }
+}
+
+void LoadWorker::onFilled(DashboardSession *s, TradeId tid){
+    if (config.holdMs <= 0) return;
+    closes.push_back({ monotonicNs() + qint64(config.holdMs) * 1000000, s, tid });
+}
+
+void LoadWorker::closeDue(qint64 now){
+    while (!closes.empty() && closes.front().dueNs <= now) {
+        const PendingClose c = closes.front();
+        closes.pop_front();
+        c.session->closeTrade(c.tradeID);
+    }
+}
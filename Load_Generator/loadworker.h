@@ -0,0 +1,85 @@
+/* =========================================================================
+   LoadWorker.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   One socket thread of the load generator: a share of the simulated
+   users and the timer that drives their orders.
+
+   Key features
+   • addUsers() queues sessions; a 10 ms tick opens them at this worker's
+     share of $LOAD_CONNECT_RATE, so a 5 000‑user step does not arrive at
+     the servers as one SYN burst.
+   • While trading, the same tick spends an order budget of
+     $LOAD_ORDER_RATE × ready users × elapsed time, round‑robin over the
+     sessions (random asset and side); users at $LOAD_MAX_OPEN are
+     skipped and counted. Fills are closed $LOAD_HOLD_MS after their ack.
+   • takeWindow() hands back the stats of the current window and starts
+     a new one.
+
+   Design notes
+   • Lives on its own QThread; the controller calls the public methods
+     through QMetaObject::invokeMethod (BlockingQueued for reads).
+   • Sessions are never deleted mid‑run – a dropped socket stays counted
+     as a disconnect and its user simply stops trading.
+   ========================================================================= */
+
+#ifndef LOADWORKER_H
+#define LOADWORKER_H
+
+#include "dashboardsession.h"
+#include "loadconfig.h"
+#include "loadstats.h"
+
+#include <QList>
+#include <QObject>
+#include <QTimer>
+
+#include <deque>
+#include <random>
+
+class LoadWorker : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int TICK_MS = 10;
+
+    LoadWorker(int index, const LoadConfig &config, QObject *parent = nullptr);
+
+    /* ---- worker‑thread API -------------------------------------------- */
+    void start();
+    void addUsers(const QList<int> &userIDs);
+    void setTrading(bool on) { trading = on; }
+    LoadStats takeWindow();
+    int  connected() const { return stats.tradeSockets; }
+    int  opening()   const { return int(connectQueue.size()); }
+
+private slots:
+    void onTick();
+    void onFilled(DashboardSession *session, TradeId tradeID);
+
+private:
+    struct PendingClose {
+        qint64            dueNs;
+        DashboardSession *session;
+        TradeId           tradeID;
+    };
+
+    void openSessions(double seconds);
+    void placeOrders(double seconds);
+    void closeDue(qint64 nowNs);
+
+    int                        workerIndex;
+    const LoadConfig          &config;
+    LoadStats                  stats;
+    QList<DashboardSession*>   sessions;
+    QList<int>                 connectQueue;
+    std::deque<PendingClose>   closes;          // due order – hold is constant
+    QTimer                     tick {this};
+    std::mt19937               rng;
+    bool                       trading       {false};
+    double                     connectCredit {0.0};
+    double                     orderCredit   {0.0};
+    int                        cursor        {0};
+    qint64                     lastTickNs    {0};
+};
+
+#endif // LOADWORKER_H
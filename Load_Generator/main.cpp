@@ -0,0 +1,26 @@
+/* =========================================================================
+   Load_Generator/main.cpp – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Headless dashboard load against TradeServer / AccountServer; prints one
+   capacity row per step and writes the curve to $LOAD_OUT. Settings are
+   environment variables, listed in LoadConfig.h.
+
+   Example – 100 → 2 000 users against a local node fed by Mock_Exchange:
+     LOAD_STEPS=100,500,1000,2000 LOAD_ORDER_RATE=0.5 ./load_generator
+   ========================================================================= */
+
+#include "loadgenerator.h"
+
+#include <QCoreApplication>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    LoadGenerator generator(LoadConfig::fromEnvironment());
+    QObject::connect(&generator, &LoadGenerator::finished,
+                     &a, &QCoreApplication::quit, Qt::QueuedConnection);
+    generator.start();
+
+    return a.exec();
+}
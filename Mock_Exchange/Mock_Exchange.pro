@@ -0,0 +1,17 @@
+QT = core
+QT += network
+QT += websockets
+
+CONFIG += c++17 cmdline
+CONFIG -= app_bundle
+
+TARGET = mock_exchange
+
+SOURCES += \
+        main.cpp \
+        mockexchange.cpp \
+        syntheticmarket.cpp
+
+HEADERS += \
+    mockexchange.h \
+    syntheticmarket.h
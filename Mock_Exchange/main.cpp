@@ -0,0 +1,40 @@
+/* =========================================================================
+   Mock_Exchange/main.cpp – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Offline Binance stand‑in: synthetic k‑line WebSocket streams and the
+   REST klines endpoint (see MockExchange.h).
+
+   Environment
+     MOCK_WS_PORT          WebSocket port              (default 19443)
+     MOCK_REST_PORT        REST port                   (default 18080)
+     MOCK_SYMBOLS          simulated symbols           (default 4)
+     MOCK_TICK_HZ          price steps per second      (default 2)
+     MOCK_VOLATILITY       annualised volatility       (default 0.8)
+     MOCK_SEED             random seed                 (default 42)
+     MOCK_INSTRUMENTS_OUT  write a $CLOUD_INSTRUMENTS file for the engine
+   ========================================================================= */
+
+#include "mockexchange.h"
+
+#include <QCoreApplication>
+
+static quint16 envPort(const char *name, quint16 fallback){
+    bool ok = false;
+    const int v = qEnvironmentVariableIntValue(name, &ok);
+    return (ok && v > 0 && v < 65536) ? quint16(v) : fallback;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    MockExchange exchange(SyntheticMarket::Config::fromEnvironment());
+    if (!exchange.listen(envPort("MOCK_WS_PORT",   MockExchange::DEFAULT_WS_PORT),
+                         envPort("MOCK_REST_PORT", MockExchange::DEFAULT_REST_PORT)))
+        return 1;
+
+    const QString instruments = qEnvironmentVariable("MOCK_INSTRUMENTS_OUT");
+    if (!instruments.isEmpty()) exchange.writeInstruments(instruments);
+
+    return a.exec();
+}
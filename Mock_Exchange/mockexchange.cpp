@@ -0,0 +1,356 @@
+/* =========================================================================
+   MockExchange.cpp – implementation of MockExchange.h
+   -------------------------------------------------------------------------
+   Stream subscriptions, per‑step kline fan‑out and the tiny klines HTTP
+   endpoint.
+   ========================================================================= */
+
+#include "mockexchange.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUrl>
+#include <QWebSocket>
+#include <QWebSocketServer>
+#include <QtDebug>
+
+namespace {
+
+constexpr int MAX_REQUEST_HEAD = 8192;
+
+inline QByteArray num(double v){ return QByteArray::number(v, 'f', 8); }
+
+QByteArray httpResponse(int status, const QByteArray &body){
+    const char *reason = status == 200 ? "OK"
+                       : status == 400 ? "Bad Request"
+                       : status == 404 ? "Not Found"
+                                       : "Method Not Allowed";
+    return "HTTP/1.1 " + QByteArray::number(status) + ' ' + reason + "\r\n"
+           "Content-Type: application/json;charset=UTF-8\r\n"
+           "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+           "Connection: close\r\n\r\n" + body;
+}
+
+/* Binance error body – {"code":-1121,"msg":"Invalid symbol."} */
+QByteArray apiError(int code, const char *msg){
+    return "{\"code\":" + QByteArray::number(code) + ",\"msg\":\"" + msg + "\"}";
+}
+
+} // namespace
+
+MockExchange::MockExchange(const SyntheticMarket::Config &config, QObject *parent)
+    : QObject(parent),
+    market(config)
+{
+    stepTimer.setTimerType(Qt::PreciseTimer);
+    connect(&stepTimer, &QTimer::timeout, this, &MockExchange::onStep);
+    stepTimer.start(qMax(1, int(1000.0 / config.tickHz)));
+
+    connect(&statsTimer, &QTimer::timeout, this, &MockExchange::logStats);
+    statsTimer.start(30000);
+}
+
+MockExchange::~MockExchange(){
+    for (QWebSocket *ws : clients.keys()) ws->abort();
+}
+
+bool MockExchange::listen(quint16 wsPort, quint16 restPort){
+    wsServer = new QWebSocketServer("MockExchange", QWebSocketServer::NonSecureMode, this);
+    if (!wsServer->listen(QHostAddress::Any, wsPort)) {
+        qWarning() << "[MockExchange] WebSocket port" << wsPort << wsServer->errorString();
+        return false;
+    }
+    connect(wsServer, &QWebSocketServer::newConnection,
+            this,     &MockExchange::onWsConnection);
+
+    httpServer = new QTcpServer(this);
+    if (!httpServer->listen(QHostAddress::Any, restPort)) {
+        qWarning() << "[MockExchange] REST port" << restPort << httpServer->errorString();
+        return false;
+    }
+    connect(httpServer, &QTcpServer::newConnection,
+            this,       &MockExchange::onHttpConnection);
+
+    qDebug() << "[MockExchange] streams on ws://0.0.0.0:" + QString::number(wsPort)
+             << "– REST on http://0.0.0.0:" + QString::number(restPort);
+    return true;
+}
+
+/* {"symbols":[…]} in the format InstrumentTable::load() reads */
+bool MockExchange::writeInstruments(const QString &path) const{
+    QJsonArray symbols;
+    for (int i = 0; i < market.size(); ++i) symbols << market.symbol(i);
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qWarning() << "[MockExchange] cannot write" << path << f.errorString();
+        return false;
+    }
+    f.write(QJsonDocument(QJsonObject{{ "symbols", symbols }}).toJson());
+    if (!f.commit()) {
+        qWarning() << "[MockExchange] cannot write" << path << f.errorString();
+        return false;
+    }
+    qDebug() << "[MockExchange] instrument list written to" << path;
+    return true;
+}
+
+/* ------------------------------ streams -------------------------------- */
+
+/* "btcusdt@kline_1m" → key; unknown symbols are added to the market */
+bool MockExchange::parseStream(const QString &stream, StreamKey &out){
+    const int at = stream.indexOf("@kline_");
+    if (at <= 0) return false;
+    const int interval = SyntheticMarket::intervalIndex(stream.mid(at + 7));
+    if (interval < 0) return false;
+    const int id = market.ensure(stream.left(at).toUpper());
+    out = (StreamKey(id) << 8) | StreamKey(interval);
+    return true;
+}
+
+QString MockExchange::streamName(StreamKey key) const{
+    return market.symbol(int(key >> 8)).toLower() + "@kline_" +
+           SyntheticMarket::intervals()[int(key & 0xFF)].name;
+}
+
+QByteArray MockExchange::klinePayload(StreamKey key, const Candle &c, qint64 eventMs) const{
+    const int        id       = int(key >> 8);
+    const int        interval = int(key & 0xFF);
+    const QByteArray sym      = market.symbol(id).toLatin1();
+
+    QByteArray p;
+    p.reserve(384);
+    p += "{\"e\":\"kline\",\"E\":" + QByteArray::number(eventMs) +
+         ",\"s\":\"" + sym + "\",\"k\":{\"t\":" + QByteArray::number(c.openTime) +
+         ",\"T\":" + QByteArray::number(c.closeTime) +
+         ",\"s\":\"" + sym + "\",\"i\":\"" + SyntheticMarket::intervals()[interval].name +
+         "\",\"f\":0,\"L\":" + QByteArray::number(c.trades) +
+         ",\"o\":\"" + num(c.open) + "\",\"c\":\"" + num(c.close) +
+         "\",\"h\":\"" + num(c.high) + "\",\"l\":\"" + num(c.low) +
+         "\",\"v\":\"" + num(c.volume) + "\",\"n\":" + QByteArray::number(c.trades) +
+         ",\"x\":" + (c.closed ? "true" : "false") +
+         ",\"q\":\"" + num(c.quoteVolume) + "\",\"V\":\"0\",\"Q\":\"0\",\"B\":\"0\"}}";
+    return p;
+}
+
+void MockExchange::onWsConnection(){
+    while (QWebSocket *ws = wsServer->nextPendingConnection()) {
+        const QUrl url = ws->requestUrl();
+        Client &c = clients[ws];
+        c.combined = url.path().startsWith("/stream");
+
+        connect(ws, &QWebSocket::textMessageReceived,
+                this, &MockExchange::onWsMessage);
+        connect(ws, &QWebSocket::disconnected,
+                this, &MockExchange::onWsDisconnected);
+
+        QStringList wanted;
+        if (c.combined)
+            wanted = QUrlQuery(url).queryItemValue("streams").split('/', Qt::SkipEmptyParts);
+        else if (url.path().startsWith("/ws/"))
+            wanted << url.path().mid(4);
+
+        int accepted = 0;
+        for (const QString &s : std::as_const(wanted))
+            if (subscribe(ws, s)) ++accepted;
+        qDebug() << "[MockExchange] client" << url.path() << "–" << accepted
+                 << "of" << wanted.size() << "streams";
+    }
+}
+
+bool MockExchange::subscribe(QWebSocket *ws, const QString &stream){
+    StreamKey key;
+    if (!parseStream(stream.toLower(), key)) {
+        qWarning() << "[MockExchange] unsupported stream" << stream;
+        return false;
+    }
+    clients[ws].streams.insert(key);
+    subscribers[key].insert(ws);
+    return true;
+}
+
+void MockExchange::unsubscribe(QWebSocket *ws, const QString &stream){
+    StreamKey key;
+    if (!parseStream(stream.toLower(), key)) return;
+    clients[ws].streams.remove(key);
+    auto it = subscribers.find(key);
+    if (it == subscribers.end()) return;
+    it->remove(ws);
+    if (it->isEmpty()) subscribers.erase(it);
+}
+
+/* {"method":"SUBSCRIBE","params":["btcusdt@kline_1m"],"id":1} */
+void MockExchange::onWsMessage(const QString &message){
+    QWebSocket *ws = qobject_cast<QWebSocket*>(sender());
+    if (!ws) return;
+
+    const QJsonObject req    = QJsonDocument::fromJson(message.toUtf8()).object();
+    const QString     method = req.value("method").toString();
+    const QJsonValue  id     = req.value("id");
+
+    if (method == "SUBSCRIBE" || method == "UNSUBSCRIBE") {
+        for (const QJsonValue &p : req.value("params").toArray()) {
+            if (method == "SUBSCRIBE") subscribe(ws, p.toString());
+            else                       unsubscribe(ws, p.toString());
+        }
+        ws->sendTextMessage(QJsonDocument(QJsonObject{{ "result", QJsonValue() },
+                                                      { "id", id }})
+                                .toJson(QJsonDocument::Compact));
+    } else if (method == "LIST_SUBSCRIPTIONS") {
+        QJsonArray list;
+        for (StreamKey k : std::as_const(clients[ws].streams)) list << streamName(k);
+        ws->sendTextMessage(QJsonDocument(QJsonObject{{ "result", list }, { "id", id }})
+                                .toJson(QJsonDocument::Compact));
+    } else {
+        ws->sendTextMessage(QString::fromLatin1(apiError(2, "Invalid request")));
+    }
+}
+
+void MockExchange::onWsDisconnected(){
+    QWebSocket *ws = qobject_cast<QWebSocket*>(sender());
+    if (!ws) return;
+    const Client c = clients.take(ws);
+    for (StreamKey key : c.streams) {
+        auto it = subscribers.find(key);
+        if (it == subscribers.end()) continue;
+        it->remove(ws);
+        if (it->isEmpty()) subscribers.erase(it);
+    }
+    ws->deleteLater();
+}
+
+/* ------------------------------------------------------------------------
+   One market step, then per subscribed stream the closing "x":true frame
+   (if the candle rolled) and the live candle – each serialised once, raw
+   and combined, and shared by every socket on the stream.
+   ------------------------------------------------------------------------ */
+void MockExchange::onStep(){
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    market.step(now);
+
+    for (auto it = subscribers.cbegin(); it != subscribers.cend(); ++it) {
+        const int id       = int(it.key() >> 8);
+        const int interval = int(it.key() & 0xFF);
+        if (market.rolled(id, interval))
+            publish(it.key(), market.lastClosed(id, interval), now);
+        publish(it.key(), market.live(id, interval), now);
+    }
+}
+
+void MockExchange::publish(StreamKey key, const Candle &candle, qint64 eventMs){
+    const QByteArray raw = klinePayload(key, candle, eventMs);
+    QString rawText, combinedText;
+    for (QWebSocket *ws : subscribers.value(key)) {
+        if (clients.value(ws).combined) {
+            if (combinedText.isEmpty())
+                combinedText = QString::fromLatin1(
+                    "{\"stream\":\"" + streamName(key).toLatin1() +
+                    "\",\"data\":" + raw + '}');
+            ws->sendTextMessage(combinedText);
+        } else {
+            if (rawText.isEmpty()) rawText = QString::fromLatin1(raw);
+            ws->sendTextMessage(rawText);
+        }
+        ++framesSent;
+    }
+}
+
+void MockExchange::logStats(){
+    qDebug() << "[MockExchange]" << clients.size() << "clients,"
+             << subscribers.size() << "streams," << framesSent << "frames,"
+             << restServed << "REST requests";
+}
+
+/* -------------------------------- REST --------------------------------- */
+
+void MockExchange::onHttpConnection(){
+    while (QTcpSocket *s = httpServer->nextPendingConnection()) {
+        connect(s, &QTcpSocket::readyRead,    this, &MockExchange::onHttpReadyRead);
+        connect(s, &QTcpSocket::disconnected, s,    &QObject::deleteLater);
+    }
+}
+
+/* Wait for the end of the request head; the body (if any) is ignored */
+void MockExchange::onHttpReadyRead(){
+    QTcpSocket *s = qobject_cast<QTcpSocket*>(sender());
+    if (!s) return;
+
+    QByteArray head = s->property("head").toByteArray() + s->readAll();
+    if (!head.contains("\r\n\r\n")) {
+        if (head.size() > MAX_REQUEST_HEAD) s->abort();
+        else                                s->setProperty("head", head);
+        return;
+    }
+    disconnect(s, &QTcpSocket::readyRead, this, &MockExchange::onHttpReadyRead);
+    serveHttp(s, head.left(head.indexOf("\r\n")));
+}
+
+void MockExchange::serveHttp(QTcpSocket *s, const QByteArray &requestLine){
+    const QList<QByteArray> parts = requestLine.split(' ');
+    int        status = 200;
+    QByteArray body;
+
+    if (parts.size() < 2 || parts[0] != "GET") {
+        status = 405;
+        body   = apiError(-1000, "Only GET is supported.");
+    } else {
+        const QUrl url(QString::fromLatin1(parts[1]));
+        const QString path = url.path();
+        if (path == "/api/v3/klines") {
+            body = klines(QUrlQuery(url), status);
+        } else if (path == "/api/v3/ping") {
+            body = "{}";
+        } else if (path == "/api/v3/time") {
+            body = "{\"serverTime\":" +
+                   QByteArray::number(QDateTime::currentMSecsSinceEpoch()) + '}';
+        } else {
+            status = 404;
+            body   = apiError(-1000, "Unknown endpoint.");
+        }
+    }
+    ++restServed;
+    s->write(httpResponse(status, body));
+    s->disconnectFromHost();
+}
+
+/* [[openTime,"o","h","l","c","v",closeTime,"q",trades,"0","0","0"], …] */
+QByteArray MockExchange::klines(const QUrlQuery &q, int &status){
+    const QString symbol = q.queryItemValue("symbol").toUpper();
+    if (symbol.isEmpty()) {
+        status = 400;
+        return apiError(-1102, "Mandatory parameter 'symbol' was not sent.");
+    }
+    const int interval = SyntheticMarket::intervalIndex(q.queryItemValue("interval"));
+    if (interval < 0) {
+        status = 400;
+        return apiError(-1120, "Invalid interval.");
+    }
+    bool ok = false;
+    int limit = q.queryItemValue("limit").toInt(&ok);
+    if (!ok) limit = 500;                              // Binance default
+
+    const QList<Candle> bars = market.history(market.ensure(symbol), interval, limit,
+                                              q.queryItemValue("startTime").toLongLong(),
+                                              q.queryItemValue("endTime").toLongLong());
+    QByteArray out;
+    out.reserve(bars.size() * 160 + 2);
+    out += '[';
+    for (int i = 0; i < bars.size(); ++i) {
+        const Candle &c = bars[i];
+        if (i) out += ',';
+        out += '[' + QByteArray::number(c.openTime) +
+               ",\"" + num(c.open) + "\",\"" + num(c.high) +
+               "\",\"" + num(c.low) + "\",\"" + num(c.close) +
+               "\",\"" + num(c.volume) + "\"," + QByteArray::number(c.closeTime) +
+               ",\"" + num(c.quoteVolume) + "\"," + QByteArray::number(c.trades) +
+               ",\"0\",\"0\",\"0\"]";
+    }
+    out += ']';
+    return out;
+}
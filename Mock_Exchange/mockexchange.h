@@ -0,0 +1,105 @@
+/* =========================================================================
+   MockExchange.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Local stand‑in for the two Binance endpoints the platform consumes, so
+   the cloud engine and the desktop client can run offline and under
+   repeatable load.
+
+   Key features
+   • WebSocket ($MOCK_WS_PORT, default 19443), same paths as
+     stream.binance.com:
+         /ws/<symbol>@kline_<interval>          raw frames
+         /stream?streams=<s1>/<s2>/…            {"stream","data"} frames
+     plus the {"method":"SUBSCRIBE"|"UNSUBSCRIBE","params":[…],"id":n}
+     control messages on either path.
+   • REST ($MOCK_REST_PORT, default 18080), same shape as api.binance.com:
+         GET /api/v3/klines?symbol=&interval=&limit=&startTime=&endTime=
+         GET /api/v3/ping          GET /api/v3/time
+   • Prices come from a SyntheticMarket stepped at $MOCK_TICK_HZ; every
+     step pushes the live candle of each subscribed stream, with "x":true
+     on the frame that closes a candle.
+   • $MOCK_INSTRUMENTS_OUT writes the symbol list as a $CLOUD_INSTRUMENTS
+     file, so the cloud engine subscribes to exactly what is simulated.
+
+   Design notes
+   • Each payload is serialised once per step per stream, however many
+     sockets subscribe to it (raw and combined framing cached apart).
+   • Plain ws:// and http:// only – point the platform at it with
+     $MARKET_DATA_WS / $BINANCE_WS_BASE = ws://host:19443 and
+     $BINANCE_REST_BASE = http://host:18080.
+   • The HTTP side is deliberately minimal: GET only, one request per
+     connection, Connection: close.
+   • Single‑threaded; everything runs on the main event loop.
+   ========================================================================= */
+
+#ifndef MOCKEXCHANGE_H
+#define MOCKEXCHANGE_H
+
+#include "syntheticmarket.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+#include <QUrlQuery>
+
+class QTcpServer;
+class QTcpSocket;
+class QWebSocket;
+class QWebSocketServer;
+
+class MockExchange : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr quint16 DEFAULT_WS_PORT   = 19443;
+    static constexpr quint16 DEFAULT_REST_PORT = 18080;
+
+    explicit MockExchange(const SyntheticMarket::Config &config,
+                          QObject *parent = nullptr);
+    ~MockExchange();
+
+    bool listen(quint16 wsPort, quint16 restPort);
+    bool writeInstruments(const QString &path) const;
+
+private slots:
+    void onStep();
+    void logStats();
+    void onWsConnection();
+    void onWsMessage(const QString &message);
+    void onWsDisconnected();
+    void onHttpConnection();
+    void onHttpReadyRead();
+
+private:
+    /* (symbol id, interval index) packed into one key */
+    using StreamKey = quint32;
+
+    struct Client {
+        bool           combined = false;
+        QSet<StreamKey> streams;
+    };
+
+    bool subscribe(QWebSocket *ws, const QString &stream);
+    void unsubscribe(QWebSocket *ws, const QString &stream);
+    bool parseStream(const QString &stream, StreamKey &out);
+    QString streamName(StreamKey key) const;
+    QByteArray klinePayload(StreamKey key, const Candle &candle, qint64 eventMs) const;
+    void       publish(StreamKey key, const Candle &candle, qint64 eventMs);
+
+    void       serveHttp(QTcpSocket *socket, const QByteArray &requestLine);
+    QByteArray klines(const QUrlQuery &query, int &status);
+
+    SyntheticMarket                          market;
+    QTimer                                   stepTimer;
+    QTimer                                   statsTimer;
+    QWebSocketServer                        *wsServer   {nullptr};
+    QTcpServer                              *httpServer {nullptr};
+    QHash<QWebSocket*, Client>               clients;
+    QHash<StreamKey, QSet<QWebSocket*>>      subscribers;
+    quint64                                  framesSent {0};
+    quint64                                  restServed {0};
+};
+
+#endif // MOCKEXCHANGE_H
@@ -0,0 +1,196 @@
+/* =========================================================================
+   SyntheticMarket.cpp – implementation of SyntheticMarket.h
+   -------------------------------------------------------------------------
+   GBM steps, candle roll‑over and on‑demand back‑fill.
+   ========================================================================= */
+
+#include "syntheticmarket.h"
+
+#include <QDateTime>
+#include <QtDebug>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double SECONDS_PER_YEAR = 365.0 * 24 * 3600;
+
+double envDouble(const char *name, double fallback){
+    bool ok = false;
+    const double v = qEnvironmentVariable(name).toDouble(&ok);
+    return ok ? v : fallback;
+}
+
+} // namespace
+
+/* $MOCK_SYMBOLS, $MOCK_VOLATILITY, $MOCK_TICK_HZ, $MOCK_SEED */
+SyntheticMarket::Config SyntheticMarket::Config::fromEnvironment(){
+    Config c;
+    bool ok = false;
+    const int n = qEnvironmentVariableIntValue("MOCK_SYMBOLS", &ok);
+    if (ok && n > 0) c.symbols = n;
+    c.volatility = qMax(0.0, envDouble("MOCK_VOLATILITY", c.volatility));
+    const double hz = envDouble("MOCK_TICK_HZ", c.tickHz);
+    if (hz > 0) c.tickHz = hz;
+    const quint64 seed = qEnvironmentVariable("MOCK_SEED").toULongLong(&ok);
+    if (ok) c.seed = seed;
+    return c;
+}
+
+const QList<SyntheticMarket::Interval> &SyntheticMarket::intervals(){
+    static const QList<Interval> table = {
+        { "1m",  60000LL },       { "3m",  180000LL },     { "5m",  300000LL },
+        { "15m", 900000LL },      { "30m", 1800000LL },    { "1h",  3600000LL },
+        { "2h",  7200000LL },     { "4h",  14400000LL },   { "6h",  21600000LL },
+        { "8h",  28800000LL },    { "12h", 43200000LL },   { "1d",  86400000LL },
+    };
+    return table;
+}
+
+int SyntheticMarket::intervalIndex(const QString &name){
+    const QList<Interval> &all = intervals();
+    for (int i = 0; i < all.size(); ++i)
+        if (name == QLatin1String(all[i].name)) return i;
+    return -1;
+}
+
+SyntheticMarket::SyntheticMarket(const Config &c)
+    : config(c),
+    stepSigma(c.volatility * std::sqrt(1.0 / (c.tickHz * SECONDS_PER_YEAR))),
+    rng(c.seed)
+{
+    static const char *builtIn[] = { "BTCUSDT", "ETHUSDT", "SOLUSDT", "XRPUSDT" };
+    for (int i = 0; i < config.symbols; ++i)
+        ensure(i < 4 ? QString(builtIn[i])
+                     : QString("MOCK%1USDT").arg(i, 3, 10, QChar('0')));
+
+    qDebug() << "[SyntheticMarket]" << books.size() << "symbols, vol"
+             << config.volatility << "at" << config.tickHz << "Hz, seed" << config.seed;
+}
+
+int SyntheticMarket::ensure(const QString &symbol){
+    const auto it = ids.constFind(symbol);
+    if (it != ids.cend()) return it.value();
+
+    Book b;
+    b.symbol = symbol;
+    if      (symbol == "BTCUSDT") b.price = 67000.0;
+    else if (symbol == "ETHUSDT") b.price = 3500.0;
+    else if (symbol == "SOLUSDT") b.price = 150.0;
+    else if (symbol == "XRPUSDT") b.price = 0.52;
+    else b.price = 1.0 + std::uniform_real_distribution<>(0.0, 99.0)(rng);
+
+    const int n = intervals().size();
+    b.live.resize(n);
+    b.closed.resize(n);
+    b.backfilled.assign(n, false);
+    b.rolled.assign(n, false);
+    const qint64 now = lastStepMs ? lastStepMs : QDateTime::currentMSecsSinceEpoch();
+    for (int i = 0; i < n; ++i) open(b, i, now);
+
+    const int id = int(books.size());
+    books.push_back(std::move(b));
+    ids.insert(symbol, id);
+    return id;
+}
+
+/* Start the candle of @p interval that contains @p nowMs at the current price */
+void SyntheticMarket::open(Book &b, int interval, qint64 nowMs){
+    const qint64 ms = intervals()[interval].ms;
+    Candle &c   = b.live[interval];
+    c           = Candle();
+    c.openTime  = nowMs / ms * ms;
+    c.closeTime = c.openTime + ms - 1;
+    c.open = c.high = c.low = c.close = b.price;
+}
+
+/* ------------------------------------------------------------------------
+   One GBM step per symbol, then fold the new price into every interval.
+   ------------------------------------------------------------------------ */
+void SyntheticMarket::step(qint64 nowMs){
+    lastStepMs = nowMs;
+    const double drift = -0.5 * stepSigma * stepSigma;
+    const int    n     = intervals().size();
+
+    for (Book &b : books) {
+        b.price *= std::exp(drift + stepSigma * gaussian());
+        const double qty = std::abs(gaussian()) * 10.0 / std::sqrt(b.price);
+
+        for (int i = 0; i < n; ++i) {
+            Candle *c = &b.live[i];
+            b.rolled[i] = nowMs > c->closeTime;
+            if (b.rolled[i]) {
+                c->closed = true;
+                std::deque<Candle> &hist = b.closed[i];
+                hist.push_back(*c);
+                if (hist.size() > std::size_t(HISTORY_BARS)) hist.pop_front();
+                open(b, i, nowMs);
+                c = &b.live[i];
+            }
+            c->close        = b.price;
+            c->high         = qMax(c->high, b.price);
+            c->low          = qMin(c->low,  b.price);
+            c->volume      += qty;
+            c->quoteVolume += qty * b.price;
+            c->trades      += 1;
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------
+   Walk back from the first live open so the synthetic past joins the live
+   candle without a gap; per‑bar sigma scales with the interval length.
+   ------------------------------------------------------------------------ */
+void SyntheticMarket::backfill(Book &b, int interval){
+    b.backfilled[interval] = true;
+    std::deque<Candle> &hist = b.closed[interval];
+    const int missing = HISTORY_BARS - int(hist.size());
+    if (missing <= 0) return;
+
+    const qint64 ms    = intervals()[interval].ms;
+    const double sigma = config.volatility * std::sqrt(ms / 1000.0 / SECONDS_PER_YEAR);
+    double       close = hist.empty() ? b.live[interval].open : hist.front().open;
+    qint64       t     = hist.empty() ? b.live[interval].openTime : hist.front().openTime;
+
+    std::vector<Candle> past;
+    past.reserve(missing);
+    for (int k = 0; k < missing; ++k) {
+        Candle c;
+        t          -= ms;
+        c.openTime  = t;
+        c.closeTime = t + ms - 1;
+        c.close     = close;
+        c.open      = close / std::exp(sigma * gaussian());
+        c.high      = qMax(c.open, c.close) * (1.0 + std::abs(gaussian()) * sigma * 0.5);
+        c.low       = qMin(c.open, c.close) * (1.0 - std::abs(gaussian()) * sigma * 0.5);
+        c.volume      = std::abs(gaussian()) * 1000.0 / std::sqrt(c.close);
+        c.quoteVolume = c.volume * c.close;
+        c.trades      = 1 + int(std::abs(gaussian()) * 500);
+        c.closed      = true;
+        past.push_back(c);
+        close = c.open;
+    }
+    for (const Candle &c : past) hist.push_front(c);   // oldest ends up first
+}
+
+QList<Candle> SyntheticMarket::history(int id, int interval, int limit,
+                                       qint64 startTime, qint64 endTime){
+    Book &b = books[id];
+    if (!b.backfilled[interval]) backfill(b, interval);
+
+    limit = qBound(1, limit, HISTORY_BARS);
+    QList<Candle> all(b.closed[interval].cbegin(), b.closed[interval].cend());
+    all << b.live[interval];
+
+    QList<Candle> out;
+    for (const Candle &c : all) {
+        if (startTime > 0 && c.openTime < startTime) continue;
+        if (endTime   > 0 && c.openTime > endTime)   continue;
+        out << c;
+    }
+    /* startTime → first `limit` bars from there; otherwise the latest */
+    if (out.size() > limit)
+        out = startTime > 0 ? out.mid(0, limit) : out.mid(out.size() - limit);
+    return out;
+}
@@ -0,0 +1,115 @@
+/* =========================================================================
+   SyntheticMarket.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Random‑walk price source behind the mock exchange.
+
+   Key features
+   • One geometric Brownian motion per symbol; the per‑step sigma comes
+     from an annualised volatility and the step rate, so $MOCK_VOLATILITY
+     means the same thing at 1 Hz and at 1 kHz.
+   • Every step updates the live candle of every supported interval
+     (1m … 1d); a candle whose period has passed is closed, kept in the
+     interval's history (last HISTORY_BARS) and a fresh one opened;
+     rolled() tells the exchange to push the final "x":true frame.
+   • history() answers the REST klines query (limit / startTime /
+     endTime). Bars before start‑up are generated on first request by
+     walking back from the first live open, so charts have a back‑fill.
+   • Symbols are created on demand – a stream or REST query for a new
+     pair simply adds it to the walk.
+
+   Design notes
+   • The four client symbols keep realistic start prices; extra symbols
+     are MOCKnnnUSDT with a seeded price between 1 and 100.
+   • Seeded std::mt19937_64 ($MOCK_SEED) – the same seed and step count
+     give the same prices, which keeps load runs comparable.
+   • Single‑threaded: owned and stepped by MockExchange on its thread.
+   ========================================================================= */
+
+#ifndef SYNTHETICMARKET_H
+#define SYNTHETICMARKET_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+#include <deque>
+#include <random>
+#include <vector>
+
+struct Candle {
+    qint64 openTime    = 0;     // ms UTC
+    qint64 closeTime   = 0;     // openTime + interval − 1
+    double open        = 0.0;
+    double high        = 0.0;
+    double low         = 0.0;
+    double close       = 0.0;
+    double volume      = 0.0;
+    double quoteVolume = 0.0;
+    int    trades      = 0;
+    bool   closed      = false;
+};
+
+class SyntheticMarket
+{
+public:
+    static constexpr int HISTORY_BARS = 1000;     // Binance's max limit
+
+    struct Config {
+        int     symbols    = 4;
+        double  volatility = 0.8;                 // annualised
+        double  tickHz     = 2.0;                 // steps / s per symbol
+        quint64 seed       = 42;
+
+        static Config fromEnvironment();
+    };
+
+    struct Interval {
+        const char *name;                         // "1m"
+        qint64      ms;
+    };
+    static const QList<Interval> &intervals();
+    static int intervalIndex(const QString &name);   // −1 if unsupported
+
+    explicit SyntheticMarket(const Config &config);
+
+    /* Symbol id for @p symbol (upper case), creating it if new. */
+    int ensure(const QString &symbol);
+    int find(const QString &symbol) const { return ids.value(symbol, -1); }
+    int size() const { return int(books.size()); }
+    QString symbol(int id) const { return books[id].symbol; }
+
+    /* Advance every symbol one step at wall‑clock @p nowMs. */
+    void step(qint64 nowMs);
+
+    const Candle &live(int id, int interval) const { return books[id].live[interval]; }
+    /* True if the last step closed a candle – lastClosed() is that bar. */
+    bool rolled(int id, int interval) const { return books[id].rolled[interval]; }
+    const Candle &lastClosed(int id, int interval) const { return books[id].closed[interval].back(); }
+    /* Newest‑last closed bars plus the live one, Binance query semantics. */
+    QList<Candle> history(int id, int interval, int limit,
+                          qint64 startTime, qint64 endTime);
+
+private:
+    struct Book {
+        QString                          symbol;
+        double                           price = 0.0;
+        std::vector<Candle>              live;      // per interval
+        std::vector<std::deque<Candle>>  closed;    // per interval
+        std::vector<bool>                backfilled;
+        std::vector<bool>                rolled;
+    };
+
+    void   open(Book &b, int interval, qint64 nowMs);
+    void   backfill(Book &b, int interval);
+    double gaussian() { return normal(rng); }
+
+    Config                        config;
+    double                        stepSigma;
+    std::mt19937_64               rng;
+    std::normal_distribution<>    normal {0.0, 1.0};
+    std::vector<Book>             books;
+    QHash<QString, int>           ids;
+    qint64                        lastStepMs {0};
+};
+
+#endif // SYNTHETICMARKET_H
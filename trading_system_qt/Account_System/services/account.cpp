@@ -10,7 +10,9 @@
 
 #include "account.h"
 #include "DatabaseManager.h"
+#include "wireprotocol.h"
 
+#include <QDateTime>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QDebug>
@@ -70,6 +72,8 @@ bool Account::verifyAccount(QString serial)
             this,       &Account::onConnected);
     connect(webSocket, &QWebSocket::textMessageReceived,
             this,       &Account::onTextMessageReceived);
+    connect(webSocket, &QWebSocket::binaryMessageReceived,
+            this,       &Account::onBinaryMessageReceived);
 
     webSocket->open(QUrl(url));
     return true;
@@ -123,6 +127,10 @@ void Account::onConnected()
     QJsonObject obj;
     obj["connection"] = "account";
     obj["userID"]     = userID;
+    if (qEnvironmentVariable("WIRE_PROTOCOL") != "json") {
+        obj["protocol"]        = "binary";
+        obj["protocolVersion"] = Wire::VERSION;
+    }
 
     webSocket->sendTextMessage(
         QJsonDocument(obj).toJson(QJsonDocument::Compact));
@@ -140,8 +148,21 @@ void Account::onTextMessageReceived(const QString &msg)
     const QString     type = obj["type"].toString();
 
     if      (type == "accountLocked") handleAccountLocked();
-    else if (type == "alphaUpdated")  handleAlphaUpdated();
-    else if (type == "tradeClosed")   handleTradeClosed();
+    else if (type == "alphaUpdated")  handleAlphaUpdated(obj["alpha"].toDouble());
+    else if (type == "tradeClosed") {
+        const QJsonObject t = obj["trade"].toObject();
+        auto *th = new TradeHistory;
+        th->setTradeID      (t["tradeID"].toString());
+        th->setUserID       (userID);
+        th->setSize         (t["size"].toDouble());
+        th->setAsset        (static_cast<Asset>(t["asset"].toInt()));
+        th->setOpenPrice    (t["openPrice"].toDouble());
+        th->setClosingPrice (t["closePrice"].toDouble());
+        th->setPnl          (t["pnl"].toDouble());
+        th->setDate         (QDateTime::fromString(t["date"].toString(),
+                                                   Qt::ISODateWithMs).toLocalTime().date());
+        handleTradeClosed(obj["balance"].toDouble(), th);
+    }
     else if (type == "equity") {
         equity = obj["equityUpdate"].toDouble();
         emit equityUpdated();
@@ -149,53 +170,85 @@ void Account::onTextMessageReceived(const QString &msg)
 }
 
 /* ------------------------------------------------------------------ */
-/* tiny helper queries used by the slots                              */
+/* Binary router – same events, WireProtocol‑encoded                  */
 /* ------------------------------------------------------------------ */
-void Account::handleBalanceUpdated()
+void Account::onBinaryMessageReceived(const QByteArray &frame)
 {
-    const QString sql =
-        QStringLiteral("SELECT balance FROM \"Account\" WHERE serial_id='%1'")
-            .arg(serialID);
-
-    QSqlQuery q(db);
-    if (q.exec(sql) && q.next()) {
-        balance = q.value(0).toDouble();
-        emit balanceUpdated(balance);
+    Wire::Reader r(frame);
+    if (!r.good()) return;
+
+    switch (r.msg()) {
+    case Wire::Msg::AccountLocked: handleAccountLocked(); break;
+    case Wire::Msg::AlphaUpdated: {
+        const double a = r.f64();
+        if (!r.good()) return;
+        handleAlphaUpdated(a);
+        break;
+    }
+    case Wire::Msg::TradeClosed: {
+        Wire::TradeClosed m;
+        if (!Wire::decode(r, m)) return;
+        auto *th = new TradeHistory;
+        th->setTradeID      (TradeIds::toString(m.tradeID));
+        th->setUserID       (userID);
+        th->setSize         (m.size);
+        th->setAsset        (static_cast<Asset>(m.asset));
+        th->setOpenPrice    (m.openPrice);
+        th->setClosingPrice (m.closePrice);
+        th->setPnl          (m.pnl);
+        th->setDate         (QDateTime::fromMSecsSinceEpoch(m.closedAtMs).date());
+        handleTradeClosed(m.balance, th);
+        break;
+    }
+    case Wire::Msg::Equity: {
+        const double e = r.f64();
+        if (!r.good()) return;
+        equity = e;
+        emit equityUpdated();
+        break;
+    }
+    default: break;
     }
 }
 
+/* ------------------------------------------------------------------ */
+/* Event handlers – values come from the event itself: the cloud      */
+/* writes "Account" behind, so re‑reading it here would be stale.     */
+/* ------------------------------------------------------------------ */
+void Account::handleBalanceUpdated(double newBalance)
+{
+    balance = newBalance;
+    emit balanceUpdated(balance);
+}
+
 void Account::handleAccountLocked()
 {
     active = false;
     emit accountLocked();
 }
 
-void Account::handleAlphaUpdated()
+void Account::handleAlphaUpdated(double newAlpha)
 {
-    const QString sql =
-        QStringLiteral("SELECT alpha FROM \"Account\" WHERE serial_id='%1'")
-            .arg(serialID);
-
-    QSqlQuery q(db);
-    if (q.exec(sql) && q.next()) {
-        alpha = q.value(0).toDouble();
-        emit alphaUpdated(alpha);
-    }
+    alpha = newAlpha;
+    emit alphaUpdated(alpha);
 }
 
 /* ------------------------------------------------------------------ */
-/* 🔑  FIX – when server says “tradeClosed” we reload the whole list  */
+/* "tradeClosed" carries the closed row itself – Trade_History is     */
+/* written behind, so reloading it here could miss this very close.  */
+/* The row replaces the open one (same trade_id) or goes on top.      */
 /* ------------------------------------------------------------------ */
-void Account::handleTradeClosed()
+void Account::handleTradeClosed(double newBalance, TradeHistory *closed)
 {
-    handleBalanceUpdated();           // balance label refresh
-
-    /* clear old cache to avoid duplicates */
-    qDeleteAll(history);
-    history.clear();
+    handleBalanceUpdated(newBalance); // balance label refresh
 
-    /* repopulate & emit */
-    retrieveTradeHistory();
+    for (int i = 0; i < history.size(); ++i) {
+        if (history[i]->getTradeID() == closed->getTradeID()) {
+            delete history.takeAt(i);
+            break;
+        }
+    }
+    history.prepend(closed);          // newest first, like the query
     emit tradeHistoryUpdated(history);
 }
 
@@ -6,7 +6,9 @@
      • Holds live state (balance, equity, alpha, max-loss) and emits Qt
        signals so QML widgets refresh automatically.
      • Maintains a single WebSocket connection to the cloud AccountServer
-       and routes inbound JSON messages to slots (balance, alpha, etc.).
+       and routes inbound JSON or WireProtocol binary messages to slots
+       (balance, alpha, etc.). Binary is offered in the handshake and used
+       once the server acks; $WIRE_PROTOCOL=json opts out.
      • Stores TradeHistory* objects and exposes them to QML via the
        Q_INVOKABLE getTradeHistoryVariant() helper.
      • verifyAccount(serial) binds a freshly launched GUI to its cloud
@@ -59,10 +61,10 @@ public:
     double getEquity() const;
     double getAlpha() const;
 
-    void handleBalanceUpdated();
+    void handleBalanceUpdated(double balance);
     void handleAccountLocked();
-    void handleAlphaUpdated();
-    void handleTradeClosed();
+    void handleAlphaUpdated(double alpha);
+    void handleTradeClosed(double balance, TradeHistory *closed);
 
     Q_INVOKABLE QVariantList getTradeHistoryVariant() const;
 
@@ -75,6 +77,7 @@ signals:
 
 private slots:
     void onTextMessageReceived(const QString &message);
+    void onBinaryMessageReceived(const QByteArray &frame);
     void onConnected();
 
 private:
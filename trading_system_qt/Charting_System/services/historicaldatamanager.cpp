@@ -5,7 +5,8 @@
    array to a QCandlestickSeries, and emits historicalDataReceived(series).
 
      • changeNetworkUrl() rebuilds the endpoint whenever asset or timeframe
-       changes, then immediately triggers fetchHistoricalData().
+       changes, then immediately triggers fetchHistoricalData(). The host
+       comes from $BINANCE_REST_BASE (ExchangeEndpoints.h).
      • fetchHistoricalData() issues the GET request and hands the raw bytes
        to parseHistoricalData() on success.
      • parseHistoricalData() loops through the k-line JSON, builds candle
@@ -17,6 +18,7 @@
 
 #include "historicaldatamanager.h"
 #include "qcandlestickset.h"
+#include "exchangeendpoints.h"
 
 #include <QDebug>
 #include <QNetworkRequest>
@@ -29,7 +31,7 @@ HistoricalDataManager::HistoricalDataManager(QObject *parent)
     : QObject(parent)
     , timeframe(OneMinute)
     , asset(BTCUSDT)
-    , url("https://api.binance.com/api/v3/klines?symbol=BTCUSDT&interval=1m&limit=100")
+    , url(Exchange::klinesUrl() + "?symbol=BTCUSDT&interval=1m&limit=100")
     , networkManager(new QNetworkAccessManager(this))
 {
     qDebug() << "[HistoricalDataManager] Constructor. URL:" << url;
@@ -98,7 +100,7 @@ void HistoricalDataManager::parseHistoricalData(const QByteArray &data){
 /* Helper – rebuild REST URL after asset / timeframe swap             */
 /* ------------------------------------------------------------------ */
 void HistoricalDataManager::changeNetworkUrl(){
-    QString base = "https://api.binance.com/api/v3/klines";
+    QString base = Exchange::klinesUrl();
 
     QString symbolStr;
     switch (asset) {
@@ -6,24 +6,30 @@
 
      • connectToWebSocket() opens the socket for the current asset/timeframe.
      • changeWebSocketUrl() rebuilds the endpoint when the user switches
-       symbol or duration, then reconnects.
-     • onTextMessageReceived() parses the JSON tick, extracts timestamp,
-       open/high/low/close plus the “x” (candle-closed) flag, and emits
-       sendTick(…).
+       symbol or duration, then reconnects. The host comes from
+       $BINANCE_WS_BASE (ExchangeEndpoints.h).
+     • onTextMessageReceived() decodes the tick in place (KlineDecoder),
+       extracts timestamp, open/high/low/close plus the “x” (candle-closed)
+       flag, and emits sendTick(…).
+     • Capture / replay hooks ($CHART_CAPTURE, $CHART_REPLAY) sit at the
+       same entry point, so a replayed session drives the chart exactly
+       like the live socket did.
    ========================================================================= */
 
 #include "livedatamanager.h"
+#include "klinedecoder.h"
+#include "exchangeendpoints.h"
 #include <QDebug>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonValue>
 
 LiveDataManager::LiveDataManager(QObject *parent)
     : QObject{parent},
-    url("wss://stream.binance.com:9443/ws/btcusdt@kline_1m"),
+    url(Exchange::klineStream("btcusdt", "kline_1m")),
     websocket(new QWebSocket)
 {
     qDebug() << "[LiveDataManager] Constructor called. URL:" << url;
+    const QString capturePath = qEnvironmentVariable("CHART_CAPTURE");
+    if (!capturePath.isEmpty())
+        capture.open(capturePath, Capture::Source::ChartFeed);
 }
 
 LiveDataManager::~LiveDataManager(){
@@ -34,6 +40,18 @@ LiveDataManager::~LiveDataManager(){
 
 void LiveDataManager::connectToWebSocket(){
     qDebug() << "[LiveDataManager] connectToWebSocket() called.";
+
+    const QString replayPath = qEnvironmentVariable("CHART_REPLAY");
+    if (!replayPath.isEmpty()) {
+        replayer = std::make_unique<Capture::Replayer>(
+            [this](const Capture::Record &r) {
+                onTextMessageReceived(QString::fromUtf8(r.frame));
+                return true;
+            });
+        replayer->start(replayPath, Capture::parseSpeed(
+                            qEnvironmentVariable("CHART_REPLAY_SPEED")));
+        return;
+    }
     connect(websocket, &QWebSocket::connected, this, [this]() {
         qDebug() << "[LiveDataManager] Connected to Binance WebSocket!";
     });
@@ -48,7 +66,6 @@ void LiveDataManager::connectToWebSocket(){
 
 void LiveDataManager::changeWebSocketUrl(){
     qDebug() << "[LiveDataManager] changeWebSocketUrl() called.";
-    QString baseUrl = "wss://stream.binance.com:9443/ws/";
     QString assetSymbol;
     switch (asset) {
     case BTCUSDT: assetSymbol = "btcusdt"; break;
@@ -65,28 +82,22 @@ void LiveDataManager::changeWebSocketUrl(){
     case FourHour:      timeFrameStr = "kline_4h";  break;
     case OneDay:        timeFrameStr = "kline_1d";  break;
     }
-    url = baseUrl + assetSymbol + "@" + timeFrameStr;
+    url = Exchange::klineStream(assetSymbol, timeFrameStr);
     qDebug() << "[LiveDataManager] New WebSocket URL:" << url;
+    if (replayer) return;                  // the capture decides the feed
     websocket->close();
     websocket->open(QUrl(url));
 }
 
 void LiveDataManager::onTextMessageReceived(const QString &message){
-    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
-    if (doc.isObject()) {
-        QJsonObject obj   = doc.object();
-        QJsonObject kline = obj["k"].toObject();
-
-        qint64 timestamp = kline["t"].toVariant().toLongLong();
-        double open      = kline["o"].toString().toDouble();
-        double high      = kline["h"].toString().toDouble();
-        double low       = kline["l"].toString().toDouble();
-        double close     = kline["c"].toString().toDouble();
-        bool   x         = kline["x"].toBool();      // candle closed flag
-
-        emit sendTick(timestamp, open, high, low, close, x);
+    KlineFrame k;
+    const bool ok = KlineDecoder::decode(message, k);
+    if (capture.isOpen())
+        capture.write(Capture::nowNs(), ok ? qint32(asset) : -1, message);
+    if (ok) {
+        emit sendTick(k.openTime, k.open, k.high, k.low, k.close, k.closed);
     } else {
-        qWarning() << "[LiveDataManager] onTextMessageReceived() failed to parse JSON.";
+        qWarning() << "[LiveDataManager] onTextMessageReceived() failed to parse kline.";
     }
 }
 
@@ -9,8 +9,13 @@
      • timeFrameChange() / assetChange() rebuild the endpoint string via
        changeWebSocketUrl(), then reconnect so the live feed matches the
        user’s selection.
-     • onTextMessageReceived() parses the k-line JSON, extracts open, high,
-       low, close, and the “x” flag (k-line closed), and emits sendTick(...).
+     • onTextMessageReceived() decodes the k-line frame in place with
+       KlineDecoder (no QJsonDocument per tick), extracts open, high, low,
+       close, and the “x” flag (k-line closed), and emits sendTick(...).
+     • $CHART_CAPTURE records every raw frame to a capture file
+       (MarketCapture.h); $CHART_REPLAY plays one back through
+       onTextMessageReceived() instead of opening the socket, at
+       $CHART_REPLAY_SPEED (1 = real time, N, max).
 
    Design notes
      • URL schema: wss://stream.binance.com:9443/ws/<symbol>@kline_<interval>
@@ -27,13 +32,14 @@
 
 #include "timeframe.h"
 #include "asset.h"
+#include "marketcapture.h"
 
 #include <QDebug>
 #include <QUrl>
 #include <QObject>
 #include <QWebSocket>
-#include <QJsonDocument>
-#include <QJsonObject>
+
+#include <memory>
 
 class ChartWidget;
 
@@ -65,6 +71,9 @@ private:
     QString     url;
     QWebSocket *websocket {nullptr};
 
+    Capture::Writer                    capture;
+    std::unique_ptr<Capture::Replayer> replayer;
+
     ChartWidget *chartWidget {nullptr};   // optional back-reference
 };
 
@@ -1,21 +1,34 @@
 /* =========================================================================
    DatabaseManager.h – Raakin Bhatti (M.Eng. capstone)
    -------------------------------------------------------------------------
-   Singleton wrapper around a persistent PostgreSQL connection.
+   Singleton wrapper around the process's PostgreSQL connections.
 
    Key features
    • Lazy‑init: initialize() returns immediately if the handle is already
      open.
-   • One shared QSqlDatabase instance for the entire process, preventing
-     duplicate connections and easing transaction scopes across modules.
+   • getDatabase() still hands out the one default connection owned by the
+     thread that called initialize().
+   • connection() gives every other thread its own named connection
+     ("db-pool-N"), cloned from the default on first use and closed when
+     that thread exits – QSqlDatabase handles may not cross threads.
+   • prepared(sql) returns a per‑thread cached QSqlQuery keyed by the SQL
+     text, so hot statements are parsed / planned once per connection.
 
    Design notes
    • Qt “QPSQL” driver; credentials are hard‑coded for this demo. Replace
      with environment variables or a secrets vault before production.
-   • Connection stays open for the lifetime of the app to avoid reconnect
-     overhead and to keep prepared‑statement plans cached.
-   • TODO: add a liveness probe (simple "SELECT 1") inside initialize()
-     after long network stalls.
+   • Health check: a connection idle for more than HEALTH_CHECK_MS is
+     probed with "SELECT 1" before use; a dead one is reopened and its
+     statement cache dropped (server‑side plans died with the session).
+   • The statement cache is capped at MAX_STATEMENTS per thread and simply
+     cleared when full – callers with unbounded SQL variety should not
+     use it.
+   • A cached query is shared by every caller on that thread: bind, exec
+     and read it to completion before the next prepared() call, which may
+     evict it (cache full / reconnect). Node‑based std::unordered_map, so
+     unrelated inserts never move it.
+   • Mirrored in Cloud_System/ and trading_system_qt/Common/services/ –
+     keep the two copies in sync.
    ========================================================================= */
 
 #ifndef DATABASEMANAGER_H
@@ -25,17 +38,26 @@
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadStorage>
+
+#include <atomic>
+#include <unordered_map>
 
 class DatabaseManager
 {
 public:
+    static constexpr int HEALTH_CHECK_MS = 30000;
+    static constexpr int MAX_STATEMENTS  = 256;
+
     /** Singleton accessor */
     static DatabaseManager& getInstance() {
         static DatabaseManager instance;  // C++11 thread‑safe init
         return instance;
     }
 
-    /** Shared connection handle */
+    /** Shared connection handle (initialising thread only) */
     QSqlDatabase& getDatabase() {
         return db;
     }
@@ -55,6 +77,7 @@ public:
         db.setPassword("Zapdos123");   // ⚠ replace before prod
 
         if (db.open()) {
+            ownerThread = QThread::currentThread();
             qDebug() << "Database connected successfully!";
             return true;
         } else {
@@ -63,7 +86,100 @@ public:
         }
     }
 
+    /**
+     * Healthy connection for the calling thread (the default one on the
+     * initialising thread, a pooled named one elsewhere).
+     */
+    QSqlDatabase& connection() {
+        ThreadSlot &s = slot();
+        if (s.lastCheck.isValid() && s.lastCheck.elapsed() < HEALTH_CHECK_MS
+            && s.db.isOpen())
+            return s.db;
+
+        bool healthy = s.db.isOpen();
+        if (healthy) {
+            QSqlQuery probe(s.db);
+            healthy = probe.exec("SELECT 1");
+        }
+        if (!healthy) {
+            qWarning() << "[DatabaseManager] reconnecting" << s.db.connectionName();
+            s.statements.clear();
+            s.db.close();
+            if (!s.db.open())
+                qWarning() << "[DatabaseManager] reconnect failed:"
+                           << s.db.lastError().text();
+        }
+        s.lastCheck.start();
+        return s.db;
+    }
+
+    /**
+     * Prepared statement for @p sql on the calling thread's connection,
+     * re‑used across calls. Bind values, then exec().
+     */
+    QSqlQuery& prepared(const QString &sql) {
+        QSqlDatabase &conn = connection();
+        ThreadSlot   &s    = slot();
+
+        auto it = s.statements.find(sql);
+        if (it != s.statements.end())
+            return it->second;
+
+        if (s.statements.size() >= std::size_t(MAX_STATEMENTS))
+            s.statements.clear();
+
+        QSqlQuery &q = s.statements.emplace(sql, QSqlQuery(conn)).first->second;
+        if (!q.prepare(sql))
+            qWarning() << "[DatabaseManager] prepare failed:"
+                       << q.lastError().text();
+        return q;
+    }
+
+    /** Named connections currently open across worker threads */
+    int poolSize() const { return pooled.load(std::memory_order_relaxed); }
+
 private:
+    /* One per thread; destroyed (and its connection removed) on thread exit */
+    struct ThreadSlot {
+        QString                                name;
+        QSqlDatabase                           db;
+        std::unordered_map<QString, QSqlQuery> statements;
+        QElapsedTimer                          lastCheck;
+        std::atomic<int>                      *counter {nullptr};
+
+        ~ThreadSlot() {
+            statements.clear();
+            if (!counter) return;             // default connection – not ours
+            db.close();
+            db = QSqlDatabase();
+            QSqlDatabase::removeDatabase(name);
+            counter->fetch_sub(1, std::memory_order_relaxed);
+        }
+    };
+
+    ThreadSlot& slot() {
+        if (!threadSlots.hasLocalData()) {
+            ThreadSlot *s = new ThreadSlot;
+            if (QThread::currentThread() == ownerThread) {
+                s->name = QSqlDatabase::defaultConnection;
+                s->db   = db;
+            } else {
+                s->name = QStringLiteral("db-pool-%1")
+                              .arg(nextId.fetch_add(1, std::memory_order_relaxed));
+                s->db   = QSqlDatabase::cloneDatabase(
+                              QSqlDatabase::defaultConnection, s->name);
+                s->counter = &pooled;
+                pooled.fetch_add(1, std::memory_order_relaxed);
+                if (!s->db.open())
+                    qWarning() << "[DatabaseManager]" << s->name
+                               << "open failed:" << s->db.lastError().text();
+            }
+            s->lastCheck.start();
+            threadSlots.setLocalData(s);
+        }
+        return *threadSlots.localData();
+    }
+
     DatabaseManager() {
         db = QSqlDatabase::addDatabase("QPSQL");
     }
@@ -76,7 +192,11 @@ private:
     DatabaseManager(const DatabaseManager&)            = delete;
     DatabaseManager& operator=(const DatabaseManager&) = delete;
 
-    QSqlDatabase db;
+    QSqlDatabase                db;
+    QThread                    *ownerThread {nullptr};
+    QThreadStorage<ThreadSlot*> threadSlots;
+    std::atomic<int>            nextId {0};
+    std::atomic<int>            pooled {0};
 };
 
 #endif // DATABASEMANAGER_H
@@ -0,0 +1,57 @@
+/* =========================================================================
+   ExchangeEndpoints.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Base URLs of the market‑data exchange, so the client can be pointed at
+   the local Mock_Exchange (or any Binance‑compatible host) without a
+   rebuild.
+
+   Key features
+   • streamBase() – $BINANCE_WS_BASE,   default wss://stream.binance.com:9443
+   • restBase()   – $BINANCE_REST_BASE, default https://api.binance.com
+   • klineStream() / klinesUrl() build the exact paths the chart and the
+     execution ticket used to hard‑code.
+
+   Design notes
+   • Read once on first use; a trailing '/' is stripped so both
+     "ws://localhost:19443" and "ws://localhost:19443/" work.
+   ========================================================================= */
+
+#ifndef EXCHANGEENDPOINTS_H
+#define EXCHANGEENDPOINTS_H
+
+#include <QString>
+#include <QtGlobal>
+
+namespace Exchange {
+
+inline QString baseFromEnv(const char *name, const char *fallback){
+    QString base = qEnvironmentVariable(name, fallback);
+    while (base.endsWith('/')) base.chop(1);
+    return base;
+}
+
+inline const QString &streamBase(){
+    static const QString base = baseFromEnv("BINANCE_WS_BASE",
+                                            "wss://stream.binance.com:9443");
+    return base;
+}
+
+inline const QString &restBase(){
+    static const QString base = baseFromEnv("BINANCE_REST_BASE",
+                                            "https://api.binance.com");
+    return base;
+}
+
+/* "btcusdt", "kline_1m" → <streamBase>/ws/btcusdt@kline_1m */
+inline QString klineStream(const QString &symbol, const QString &stream){
+    return streamBase() + "/ws/" + symbol + "@" + stream;
+}
+
+/* <restBase>/api/v3/klines (query string appended by the caller) */
+inline QString klinesUrl(){
+    return restBase() + "/api/v3/klines";
+}
+
+} // namespace Exchange
+
+#endif // EXCHANGEENDPOINTS_H
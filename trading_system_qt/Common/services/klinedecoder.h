@@ -0,0 +1,292 @@
+/* =========================================================================
+   KlineDecoder.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Allocation‑free decoder for Binance kline / aggTrade WebSocket frames.
+
+   Key features
+   • Scans the frame in place – no QJsonDocument, no QJsonObject, no
+     temporary QString – and fills a plain KlineFrame struct.
+   • Works directly on QString's UTF‑16 buffer or on raw UTF‑8 bytes
+     (template over the code‑unit type), so the text‑frame path does not
+     even pay for toUtf8().
+   • Understands raw /ws frames, combined /stream frames ({"stream",
+     "data"} wrapper) and aggTrade events (p/q mapped onto OHLC/volume).
+   • symbolHash is an FNV‑1a hash of the "s" field, letting callers route
+     by symbol with an integer key instead of building a QString.
+
+   Design notes
+   • Decimal strings are parsed by hand (integer mantissa ÷ 10^k) and
+     are immune to the C locale that strtod() would pick up from
+     QCoreApplication. Up to 15 significant digits (and k ≤ 22) both
+     operands are exact doubles, so the one division is correctly
+     rounded – the same double strtod() returns; Binance's padded
+     8‑decimal fields stay inside that. Longer mantissas are
+     truncated to 19 digits and may be off by an ulp.
+   • Unknown keys, arrays and nested objects are skipped; nesting deeper
+     than MAX_DEPTH rejects the frame rather than recursing further.
+   • Mirrored byte‑for‑byte in Cloud_System/ and trading_system_qt/Common/
+     services/ – keep the two copies in sync.
+   ========================================================================= */
+
+#ifndef KLINEDECODER_H
+#define KLINEDECODER_H
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QString>
+
+struct KlineFrame {
+    qint64  eventTime  = 0;      // "E"   – event time, ms UTC
+    qint64  openTime   = 0;      // k."t" – candle open (aggTrade: "T")
+    double  open       = 0.0;    // k."o"
+    double  high       = 0.0;    // k."h"
+    double  low        = 0.0;    // k."l"
+    double  close      = 0.0;    // k."c" (aggTrade: "p")
+    double  volume     = 0.0;    // k."v" (aggTrade: "q")
+    bool    closed     = false;  // k."x" (aggTrade: always true)
+    bool    aggTrade   = false;  // "e" == "aggTrade"
+    quint64 symbolHash = 0;      // FNV‑1a of "s", upper‑cased
+};
+
+namespace KlineDecoder {
+
+constexpr int     MAX_DEPTH  = 8;
+constexpr quint64 FNV_OFFSET = 14695981039346656037ull;
+constexpr quint64 FNV_PRIME  = 1099511628211ull;
+
+inline quint64 hashStep(quint64 h, unsigned c){
+    if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+    return (h ^ (c & 0xFF)) * FNV_PRIME;
+}
+
+/* Same hash as KlineFrame::symbolHash, for building routing tables. */
+inline quint64 symbolHash(const QString &symbol){
+    quint64 h = FNV_OFFSET;
+    for (QChar c : symbol) h = hashStep(h, c.unicode());
+    return h;
+}
+
+namespace detail {
+
+template <typename Ch>
+struct Scanner {
+    const Ch *p;
+    const Ch *end;
+    KlineFrame &out;
+
+    enum Ctx { Root, Kline, Skip };
+
+    void ws(){
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+            ++p;
+    }
+
+    /* Skip the body of a string; p sits just after the opening quote. */
+    bool skipString(){
+        while (p < end) {
+            if (*p == '\\') { p += 2; continue; }
+            if (*p++ == '"') return true;
+        }
+        return false;
+    }
+
+    /* Decimal inside quotes ("0.0010") or bare (1672515782136). */
+    double number(){
+        bool     neg = false;
+        quint64  mant = 0;
+        int      digits = 0, scale = 0, exp10 = 0;
+
+        if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+        for (; p < end && *p >= '0' && *p <= '9'; ++p)
+            if (digits < 19) { mant = mant * 10 + (*p - '0'); if (mant) ++digits; }
+            else             ++exp10;
+        if (p < end && *p == '.') {
+            for (++p; p < end && *p >= '0' && *p <= '9'; ++p)
+                if (digits < 19) { mant = mant * 10 + (*p - '0'); ++scale; if (mant) ++digits; }
+        }
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            ++p;
+            bool eneg = false;
+            if (p < end && (*p == '-' || *p == '+')) eneg = (*p++ == '-');
+            int e = 0;
+            for (; p < end && *p >= '0' && *p <= '9'; ++p)
+                if (e < 400) e = e * 10 + (*p - '0');
+            exp10 += eneg ? -e : e;
+        }
+
+        static constexpr double P10[] = {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10,
+            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21,
+            1e22 };
+        double v = static_cast<double>(mant);
+        int    e = exp10 - scale;
+        while (e > 0) { const int s = e > 22 ? 22 : e; v *= P10[s]; e -= s; }
+        while (e < 0) { const int s = -e > 22 ? 22 : -e; v /= P10[s]; e += s; }
+        return neg ? -v : v;
+    }
+
+    qint64 integer(){
+        bool   neg = false;
+        qint64 v   = 0;
+        if (p < end && *p == '-') { neg = true; ++p; }
+        for (; p < end && *p >= '0' && *p <= '9'; ++p) v = v * 10 + (*p - '0');
+        return neg ? -v : v;
+    }
+
+    /* Quoted number: p sits on the opening quote. */
+    double quotedNumber(){
+        ++p;
+        const double v = number();
+        return skipString() ? v : 0.0;
+    }
+
+    bool skipValue(int depth){
+        if (p >= end) return false;
+        if (*p == '"') { ++p; return skipString(); }
+        if (*p == '{') return object(Skip, depth + 1);
+        if (*p == '[') return array(depth + 1);
+        while (p < end && *p != ',' && *p != '}' && *p != ']') ++p;
+        return p < end;
+    }
+
+    bool array(int depth){
+        if (depth > MAX_DEPTH) return false;
+        ++p;                                        // '['
+        for (;;) {
+            ws();
+            if (p >= end) return false;
+            if (*p == ']') { ++p; return true; }
+            if (!skipValue(depth)) return false;
+            ws();
+            if (p < end && *p == ',') ++p;
+        }
+    }
+
+    bool object(Ctx ctx, int depth){
+        if (depth > MAX_DEPTH) return false;
+        ++p;                                        // '{'
+        for (;;) {
+            ws();
+            if (p >= end) return false;
+            if (*p == '}') { ++p; return true; }
+            if (*p != '"') return false;
+
+            /* Key – only the first 8 code units matter (Binance keys are
+               1‑6 chars); longer keys can never match and are skipped. */
+            ++p;
+            char key[8] = {};
+            int  klen   = 0;
+            while (p < end && *p != '"') {
+                if (klen < 8) key[klen] = static_cast<char>(*p);
+                ++klen; ++p;
+            }
+            if (p >= end) return false;
+            ++p;
+            ws();
+            if (p >= end || *p != ':') return false;
+            ++p;
+            ws();
+            if (p >= end) return false;
+
+            if (!value(ctx, key, klen, depth)) return false;
+
+            ws();
+            if (p < end && *p == ',') ++p;
+        }
+    }
+
+    bool value(Ctx ctx, const char *key, int klen, int depth){
+        if (ctx == Skip) return skipValue(depth);
+
+        if (klen == 1) {
+            const char k = key[0];
+            if (ctx == Kline) {
+                switch (k) {
+                case 'o': if (*p == '"') { out.open   = quotedNumber(); return true; } break;
+                case 'h': if (*p == '"') { out.high   = quotedNumber(); return true; } break;
+                case 'l': if (*p == '"') { out.low    = quotedNumber(); return true; } break;
+                case 'c': if (*p == '"') { out.close  = quotedNumber(); return true; } break;
+                case 'v': if (*p == '"') { out.volume = quotedNumber(); return true; } break;
+                case 't': if (*p != '"') { out.openTime = integer();    return true; } break;
+                case 'x':
+                    out.closed = (*p == 't');
+                    return skipValue(depth);
+                }
+                return skipValue(depth);
+            }
+
+            /* Root (or the "data" wrapper of a combined frame) */
+            switch (k) {
+            case 'k':
+                if (*p == '{') return object(Kline, depth + 1);
+                break;
+            case 'E': if (*p != '"') { out.eventTime = integer(); return true; } break;
+            case 'T': if (*p != '"') { out.openTime  = integer(); return true; } break;
+            case 'p': if (*p == '"') { out.close     = quotedNumber(); return true; } break;
+            case 'q': if (*p == '"') { out.volume    = quotedNumber(); return true; } break;
+            case 's':
+                if (*p == '"') {
+                    quint64 h = FNV_OFFSET;
+                    for (++p; p < end && *p != '"'; ++p) h = hashStep(h, *p);
+                    if (p >= end) return false;
+                    ++p;
+                    out.symbolHash = h;
+                    return true;
+                }
+                break;
+            case 'e':
+                if (*p == '"') {
+                    static const char agg[] = "aggTrade";
+                    const Ch *s = ++p;
+                    if (!skipString()) return false;
+                    const int n = static_cast<int>(p - s) - 1;
+                    out.aggTrade = (n == 8);
+                    for (int i = 0; out.aggTrade && i < 8; ++i)
+                        out.aggTrade = (s[i] == agg[i]);
+                    return true;
+                }
+                break;
+            }
+            return skipValue(depth);
+        }
+
+        if (klen == 4 && key[0] == 'd' && key[1] == 'a' &&
+            key[2] == 't' && key[3] == 'a' && *p == '{')
+            return object(Root, depth + 1);
+
+        return skipValue(depth);
+    }
+};
+
+} // namespace detail
+
+/* ------------------------------------------------------------------------
+   Decode one frame. @return true if a close/trade price was found.
+   @p out is reset first, so a false return never leaves stale fields.
+   ------------------------------------------------------------------------ */
+template <typename Ch>
+inline bool decode(const Ch *data, qsizetype len, KlineFrame &out){
+    out = KlineFrame();
+    detail::Scanner<Ch> s { data, data + len, out };
+    s.ws();
+    if (s.p >= s.end || *s.p != '{') return false;
+    if (!s.object(detail::Scanner<Ch>::Root, 1)) return false;
+
+    if (out.aggTrade) {
+        out.open = out.high = out.low = out.close;
+        out.closed = true;
+    }
+    return out.close > 0.0;
+}
+
+inline bool decode(const QString &frame, KlineFrame &out){
+    return decode(frame.utf16(), frame.size(), out);
+}
+
+inline bool decode(const QByteArray &frame, KlineFrame &out){
+    return decode(frame.constData(), frame.size(), out);
+}
+
+} // namespace KlineDecoder
+
+#endif // KLINEDECODER_H
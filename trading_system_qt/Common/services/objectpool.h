@@ -0,0 +1,180 @@
+/* =========================================================================
+   ObjectPool.h – Raakin Bhatti (M.Eng. capstone)
+   -------------------------------------------------------------------------
+   Fixed‑size slab allocator for small, high‑churn records (Trade).
+
+   Key features
+   • Blocks are carved out of slabs of blocksPerSlab and recycled through
+     an intrusive free list – allocate() / deallocate() are a pointer pop /
+     push, and the general heap is only touched when a slab is added.
+   • Slabs are never returned while the pool lives, so a long session that
+     opens and closes thousands of positions per second settles on a fixed
+     footprint instead of fragmenting the heap.
+   • Every pool registers itself; SlabPool::totals() sums allocations,
+     frees, heap allocations (slabs, or every block when pooling is off),
+     live and peak blocks across all pools for the stats log.
+   • pooled = false forwards every block to ::operator new / delete while
+     keeping the same counters – the baseline for before / after numbers.
+
+   Design notes
+   • Not thread‑safe by design: one pool per thread (see Trade.cpp), and a
+     block must be freed on the thread that allocated it – true for the
+     engine shards and the GUI thread alike. A pool that dies with
+     blocks still outstanding (or with foreign ones on its free list)
+     keeps its slabs rather than risk a dangling free.
+   • Counters are relaxed atomics written only by the owning thread (plain
+     load + store, no locked RMW) so the stats timer can read them from
+     elsewhere without slowing the hot path.
+   • Header‑only; mirrored in Cloud_System/ and trading_system_qt/Common/
+     services/ – keep the two copies in sync.
+   ========================================================================= */
+
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtGlobal>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+class SlabPool
+{
+public:
+    struct Stats {
+        quint64 allocations     = 0;
+        quint64 frees           = 0;
+        quint64 heapAllocations = 0;
+        qint64  live            = 0;
+        qint64  peak            = 0;
+        int     pools           = 0;
+    };
+
+    SlabPool(std::size_t blockSize, std::size_t blocksPerSlab, bool pooled = true)
+        : blockSize(roundUp(blockSize)),
+        blocksPerSlab(blocksPerSlab ? blocksPerSlab : 1),
+        pooled(pooled)
+    {
+        QMutexLocker lock(&registryMutex());
+        registry().append(this);
+    }
+
+    ~SlabPool(){
+        {
+            QMutexLocker lock(&registryMutex());
+            registry().removeOne(this);
+        }
+        if (live.load(std::memory_order_relaxed) != 0)
+            return;                   // blocks still out – leave slabs be
+        for (char *slab : slabs)
+            ::operator delete(slab);
+    }
+
+    SlabPool(const SlabPool&)            = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    void *allocate(){
+        bump(allocs);
+        const qint64 n = live.load(std::memory_order_relaxed) + 1;
+        live.store(n, std::memory_order_relaxed);
+        if (n > peak.load(std::memory_order_relaxed))
+            peak.store(n, std::memory_order_relaxed);
+
+        if (!pooled) {
+            bump(heap);
+            return ::operator new(blockSize);
+        }
+        if (!freeList) grow();
+        Node *node = freeList;
+        freeList   = node->next;
+        return node;
+    }
+
+    void deallocate(void *p){
+        if (!p) return;
+        bump(frees);
+        live.store(live.load(std::memory_order_relaxed) - 1,
+                   std::memory_order_relaxed);
+
+        if (!pooled) {
+            ::operator delete(p);
+            return;
+        }
+        Node *node = static_cast<Node*>(p);
+        node->next = freeList;
+        freeList   = node;
+    }
+
+    Stats stats() const{
+        Stats s;
+        s.allocations     = allocs.load(std::memory_order_relaxed);
+        s.frees           = frees.load(std::memory_order_relaxed);
+        s.heapAllocations = heap.load(std::memory_order_relaxed);
+        s.live            = live.load(std::memory_order_relaxed);
+        s.peak            = peak.load(std::memory_order_relaxed);
+        s.pools           = 1;
+        return s;
+    }
+
+    /* Sum over every live pool (peak is the sum of per‑pool peaks). */
+    static Stats totals(){
+        Stats t;
+        QMutexLocker lock(&registryMutex());
+        for (const SlabPool *p : registry()) {
+            const Stats s = p->stats();
+            t.allocations     += s.allocations;
+            t.frees           += s.frees;
+            t.heapAllocations += s.heapAllocations;
+            t.live            += s.live;
+            t.peak            += s.peak;
+            t.pools           += 1;
+        }
+        return t;
+    }
+
+private:
+    struct Node { Node *next; };
+
+    static std::size_t roundUp(std::size_t n){
+        const std::size_t a = alignof(std::max_align_t);
+        n = n < sizeof(Node) ? sizeof(Node) : n;
+        return (n + a - 1) / a * a;
+    }
+
+    template <typename T>
+    static void bump(std::atomic<T> &c){
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void grow(){
+        char *slab = static_cast<char*>(::operator new(blockSize * blocksPerSlab));
+        slabs.push_back(slab);
+        bump(heap);
+        for (std::size_t i = blocksPerSlab; i-- > 0; ) {
+            Node *node = reinterpret_cast<Node*>(slab + i * blockSize);
+            node->next = freeList;
+            freeList   = node;
+        }
+    }
+
+    static QMutex &registryMutex(){ static QMutex m; return m; }
+    static QList<SlabPool*> &registry(){ static QList<SlabPool*> r; return r; }
+
+    const std::size_t     blockSize;
+    const std::size_t     blocksPerSlab;
+    const bool            pooled;
+    Node                 *freeList {nullptr};
+    std::vector<char*>    slabs;
+
+    std::atomic<quint64>  allocs {0};
+    std::atomic<quint64>  frees  {0};
+    std::atomic<quint64>  heap   {0};
+    std::atomic<qint64>   live   {0};
+    std::atomic<qint64>   peak   {0};
+};
+
+#endif // OBJECTPOOL_H
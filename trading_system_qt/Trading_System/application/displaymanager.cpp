@@ -11,7 +11,8 @@
        running P & L even before the cloud sends its next snapshot.
      • Performs local risk checks (equity & max-loss) before emitting a
        placeTrade(…) signal to WebSocketClient; rejects the order in-GUI if
-       limits are hit.
+       limits are hit. The cloud re-checks every order and answers with an
+       orderAck; a reject there flips the ticket banner to red.
      • Forwards close-trade presses from TradeWidget to the cloud and
        removes the row immediately on the next onClosedTrade() callback.
    ========================================================================= */
@@ -19,6 +20,8 @@
 #include "displaymanager.h"
 #include "tradewidget.h"
 #include "executionwidget.h"
+#include "klinedecoder.h"
+#include "exchangeendpoints.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
@@ -29,7 +32,7 @@
 DisplayManager::DisplayManager(QObject *parent)
     : QObject{parent},
     webSocket(new QWebSocket),
-    url("wss://stream.binance.com:9443/ws/btcusdt@kline_1m"),
+    url(Exchange::klineStream("btcusdt", "kline_1m")),
     account(Account::getInstance())
 {
     connect(webSocket, &QWebSocket::textMessageReceived,
@@ -54,8 +57,14 @@ void DisplayManager::setWebSocketClient(WebSocketClient *webSocketClient){
     this->webSocketClient = webSocketClient;
     connect(webSocketClient, &WebSocketClient::liveTrade,
             this,            &DisplayManager::onLiveTrade);
+    connect(webSocketClient, &WebSocketClient::liveTrades,
+            this,            &DisplayManager::onLiveTrades);
     connect(webSocketClient, &WebSocketClient::closeTradeIncomming,
             this,            &DisplayManager::onClosedTrade);
+    connect(webSocketClient, &WebSocketClient::orderAck,
+            this,            &DisplayManager::onOrderAck);
+    connect(webSocketClient, &WebSocketClient::orderThrottled,
+            this,            &DisplayManager::onOrderThrottled);
 }
 
 DisplayManager::~DisplayManager() = default;
@@ -64,7 +73,6 @@ DisplayManager::~DisplayManager() = default;
    Switch Binance feed when user picks a new asset
    ---------------------------------------------------------------- */
 void DisplayManager::changeWebSocketUrl(){
-    QString baseUrl = "wss://stream.binance.com:9443/ws/";
     QString assetSymbol;
     switch (asset) {
     case BTCUSDT: assetSymbol = "btcusdt"; break;
@@ -73,7 +81,7 @@ void DisplayManager::changeWebSocketUrl(){
     case XRPUSDT: assetSymbol = "xrpusdt"; break;
     }
 
-    url = baseUrl + assetSymbol + "@kline_1m";
+    url = Exchange::klineStream(assetSymbol, "kline_1m");
     webSocket->close();
     webSocket->open(QUrl(url));
     qDebug() << "[DisplayManager] WebSocket URL changed to" << url;
@@ -88,43 +96,64 @@ QMap<Trade*, double> DisplayManager::getTradeMap() const{
    Binance k-line tick → emit best bid/ask to ExecutionWidget
    ---------------------------------------------------------------- */
 void DisplayManager::onTextMessageReceived(const QString &message){
-    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
-    if (!doc.isObject()) {
-        qWarning() << "[DisplayManager] JSON parse failure.";
+    KlineFrame k;
+    if (!KlineDecoder::decode(message, k)) {
+        qWarning() << "[DisplayManager] kline decode failure.";
         return;
     }
-    QJsonObject kline = doc.object()["k"].toObject();
-    double high = kline["h"].toString().toDouble();
-    double low  = kline["l"].toString().toDouble();
-    emit liveAssetPrice(high, low);
+    emit liveAssetPrice(k.high, k.low);
 }
 
 /* ------------------------------------------------------------------
    liveTrade event – insert / update running PnL and notify UI
    ---------------------------------------------------------------- */
 void DisplayManager::onLiveTrade(Trade* trade, double pnL){
-    bool found = false;
-    for (auto it = tradeMap.begin(); it != tradeMap.end(); ++it) {
-        if (it.key()->getTradeID() == trade->getTradeID()) {
-            it.value() = pnL; found = true; break;
-        }
-    }
-    if (!found) tradeMap.insert(trade, pnL);
+    upsertTrade(trade, pnL);
     emit tradeMapUpdated();
 }
 
-/* closedTrade event – drop row and notify UI ------------------------ */
-void  DisplayManager::onClosedTrade(QString tradeID){
-    for (auto it = tradeMap.begin(); it != tradeMap.end(); ++it) {
-        if (it.key()->getTradeID() == tradeID) {
-            delete it.key();
-            tradeMap.erase(it);
-            emit tradeMapUpdated();
-            break;
-        }
+/* batched snapshot – apply every row, repaint once ------------------ */
+void DisplayManager::onLiveTrades(const QList<QPair<Trade*, double>> &updates){
+    for (const auto &u : updates)
+        upsertTrade(u.first, u.second);
+    emit tradeMapUpdated();
+}
+
+void DisplayManager::upsertTrade(Trade* trade, double pnL){
+    auto it = tradeMap.find(trade);
+    if (it != tradeMap.end()) {
+        it.value() = pnL;
+    } else {
+        tradeMap.insert(trade, pnL);
+        tradesById.insert(trade->getTradeID(), trade);
     }
 }
 
+/* closedTrade event – drop row and notify UI ------------------------ */
+void  DisplayManager::onClosedTrade(TradeId tradeID){
+    Trade *t = tradesById.take(tradeID);
+    if (!t) return;
+    tradeMap.remove(t);
+    delete t;
+    emit tradeMapUpdated();
+}
+
+/* Server risk gate verdict – only rejects need surfacing ------------ */
+void DisplayManager::onOrderAck(quint64 clientOrderID, TradeId tradeID,
+                                bool accepted, QString reason){
+    Q_UNUSED(tradeID);
+    if (accepted) return;
+    qWarning() << "[DisplayManager] order" << clientOrderID
+               << "rejected by server:" << reason;
+    emit orderSuccesful(false);
+}
+
+/* Server back-pressure report – orders beyond the rate are parked ---- */
+void DisplayManager::onOrderThrottled(int queued, int rejected){
+    qWarning() << "[DisplayManager] server throttling orders – queued"
+               << queued << "rejected" << rejected;
+}
+
 /* ------------------------------------------------------------------
    Validate & forward new-trade request from ExecutionWidget
    ---------------------------------------------------------------- */
@@ -164,6 +193,6 @@ void DisplayManager::assetChange(int assetIndex){
 }
 
 /* forward close-trade button press --------------------------------- */
-void DisplayManager::closeTradeRequested(QString tradeID){
+void DisplayManager::closeTradeRequested(TradeId tradeID){
     emit closeTrade(tradeID);
 }
@@ -6,13 +6,20 @@
    TradeServer.
 
      • Maintains a local QMap<Trade*, double> so open positions and their
-       running P & L are visible even if the cloud feed lags.
+       running P & L are visible even if the cloud feed lags, plus a
+       QHash<TradeId, Trade*> index so a close is found in O(1).
      • Forwards UI actions upstream:
          – placeTrade(…)  → “newTrade” JSON on the socket
          – closeTrade(id) → “closeTrade” JSON on the socket
      • Forwards cloud events downstream:
          – onLiveTrade()  → updates the map and TradeWidget
+         – onLiveTrades() → applies a whole "positions" batch, then
+                            repaints once
          – onClosedTrade()→ removes the position and updates equity label
+         – onOrderAck()   → a server‑side risk reject turns the order
+                            ticket red (orderSuccesful(false))
+         – onOrderThrottled() → logs the server's queued / rejected
+                                order counts while it is rate‑limiting
 
    Design notes
      • changeWebSocketUrl() rebuilds the endpoint string when the user
@@ -52,13 +59,13 @@ public:
 
 signals:
     /* --- outbound to cloud --------------------------------------- */
-    void closeTrade(QString tradeID);
+    void closeTrade(TradeId tradeID);
     void placeTrade(double stopLoss, double takeProfit, double size,
                     int asset, double openPrice, QString type,
                     QString position);
 
     /* --- inbound to GUI ------------------------------------------ */
-    void closeTradeLocal(QString tradeID);
+    void closeTradeLocal(TradeId tradeID);
     void tradeMapUpdated();
     void liveAssetPrice(double bid, double sell);
     void orderSuccesful(bool sucess);
@@ -69,18 +76,25 @@ private slots:
 
     /* decoded events */
     void onLiveTrade(Trade* trade, double pnL);
-    void onClosedTrade(QString tradeID);
+    void onLiveTrades(const QList<QPair<Trade*, double>> &updates);
+    void onClosedTrade(TradeId tradeID);
+    void onOrderAck(quint64 clientOrderID, TradeId tradeID, bool accepted,
+                    QString reason);
+    void onOrderThrottled(int queued, int rejected);
 
     /* UI inputs */
     void inputTrade(double stopLoss, double takeProfit, double size,
                     int asset, double openPrice, QString type,
                     QString position);
-    void closeTradeRequested(QString tradeID);
+    void closeTradeRequested(TradeId tradeID);
 
 private:
+    void upsertTrade(Trade* trade, double pnL);
+
     WebSocketClient     *webSocketClient;
     QWebSocket          *webSocket;
     QMap<Trade*, double> tradeMap;          // open positions → running PnL
+    QHash<TradeId, Trade*> tradesById;      // index into tradeMap
     QString              url;
     Asset                asset {BTCUSDT};
 
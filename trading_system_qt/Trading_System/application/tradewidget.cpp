@@ -63,7 +63,7 @@ void TradeWidget::onTradeMapUpdated(){
 
 /* close-button pressed in QML -------------------------------------- */
 void TradeWidget::onCloseTradeClicked(QString tradeID){
-    emit closeTradePressed(tradeID);
+    emit closeTradePressed(TradeIds::fromString(tradeID));
 }
 
 /* Push full trade list into QML ListView --------------------------- */
@@ -82,7 +82,7 @@ void TradeWidget::syncTrades(const QMap<Trade*, double> &trades){
             qmlRootObject,
             "upsertTrade",
             Qt::DirectConnection,
-            Q_ARG(QVariant, t->getTradeID()),
+            Q_ARG(QVariant, t->getTradeIDString()),
             Q_ARG(QVariant, assetToString(static_cast<Asset>(t->getAsset()))),
             Q_ARG(QVariant, t->getStopLoss()),
             Q_ARG(QVariant, t->getTakeProfit()),
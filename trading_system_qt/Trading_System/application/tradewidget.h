@@ -9,7 +9,8 @@
        ListView can repaint.
      • onCloseTradeClicked(id) is invoked from QML when the user presses
        the close-button next to a row; the signal closeTradePressed(id)
-       bubbles up to DisplayManager → TradeServer.
+       bubbles up to DisplayManager → TradeServer. QML only ever sees the
+       decimal string form of a TradeId; it is parsed back here.
      • assetToString(Asset) maps enum to a short symbol for display.
 
    Design notes
@@ -42,7 +43,7 @@ public:
     Q_INVOKABLE void onCloseTradeClicked(QString tradeID);
 
 signals:
-    void closeTradePressed(const QString &tradeID);
+    void closeTradePressed(TradeId tradeID);
 
 private slots:
     void onTradeMapUpdated();
@@ -1,50 +1,80 @@
 /* =========================================================================
    Trade.cpp – implementation of Trade.h
    -------------------------------------------------------------------------
-   Simple data holder for individual trades; only responsibilities are
-   ID generation and basic getters/setters. No heavy business logic here –
-   performance‑critical operations occur in higher‑level managers.
+   Simple data holder for individual trades; basic getters/setters plus
+   the per‑thread slab pool behind operator new / delete. No heavy business
+   logic here – performance‑critical operations occur in higher‑level
+   managers.
    ========================================================================= */
 
 #include "trade.h"
 
-// Static counter ensures every auto‑generated ID is unique across the
-// process lifetime.
-int Trade::tradeCounter = 0;
+namespace {
 
-// Build a unique ID: Trade_<YYYYMMDDhhmmssmmm>_<incrementing counter>
-void Trade::generateTradeID(){
-    QString timestamp = QDateTime::currentDateTime()
-    .toString("yyyyMMddhhmmsszzz");
-    tradeID = "Trade_" + timestamp + "_" + QString::number(++tradeCounter);
+constexpr std::size_t TRADES_PER_SLAB = 256;
+
+/* One pool per thread: shards and the GUI thread never share blocks. */
+SlabPool &tradePool(){
+    static const bool pooled = qEnvironmentVariable("TRADE_POOL") != "off";
+    thread_local SlabPool pool(sizeof(Trade), TRADES_PER_SLAB, pooled);
+    return pool;
+}
+
+} // namespace
+
+void *Trade::operator new(std::size_t size){
+    if (size != sizeof(Trade)) return ::operator new(size);
+    return tradePool().allocate();
+}
+
+void Trade::operator delete(void *p){
+    tradePool().deallocate(p);
+}
+
+SlabPool::Stats Trade::poolStats(){
+    return SlabPool::totals();
+}
+
+TradeSide Trade::sideFromString(const QString &position){
+    return position == QLatin1String("long") ? TradeSide::Long : TradeSide::Short;
+}
+
+OrderType Trade::orderTypeFromString(const QString &){
+    return OrderType::Market;                 // only market orders exist
 }
 
 /* -------------------------------------------------------------------------
-   Constructor for existing trades (ID supplied by persistence layer).
+   Constructor for filled trades (ID assigned by the engine).
    ------------------------------------------------------------------------- */
-Trade::Trade(QString tradeID, double stopLoss, double takeProfit, double size,
+Trade::Trade(TradeId tradeID, double stopLoss, double takeProfit, double size,
+             Asset asset, double openPrice, OrderType type, TradeSide side)
+    : tradeID(tradeID), stopLoss(stopLoss), takeProfit(takeProfit), size(size),
+    openPrice(openPrice), asset(asset), type(type), position(side)
+{
+}
+
+Trade::Trade(TradeId tradeID, double stopLoss, double takeProfit, double size,
              Asset asset, double openPrice, QString type, QString position)
-    : tradeID(tradeID), stopLoss(stopLoss), takeProfit(takeProfit), size(size), asset(asset),
-    openPrice(openPrice), type(type), position(position)
+    : Trade(tradeID, stopLoss, takeProfit, size, asset, openPrice,
+            orderTypeFromString(type), sideFromString(position))
 {
 }
 
 /* -------------------------------------------------------------------------
-   Constructor for new trades – auto‑generates a unique ID.
+   Constructor for a new order – ID stays 0 until the cloud fills it.
    ------------------------------------------------------------------------- */
 Trade::Trade(double stopLoss, double takeProfit, double size,
              Asset asset, double openPrice, QString type, QString position)
-    : stopLoss(stopLoss), takeProfit(takeProfit), size(size), asset(asset),
-    openPrice(openPrice), type(type), position(position)
+    : Trade(0, stopLoss, takeProfit, size, asset, openPrice,
+            std::move(type), std::move(position))
 {
-    generateTradeID();
 }
 
 Trade::~Trade() {}
 
 // Basic getters/setters follow – trivial, no extra comments needed.
 
-QString Trade::getTradeID() const {
+TradeId Trade::getTradeID() const {
     return tradeID;
 }
 
@@ -77,13 +107,14 @@ double Trade::getOpenPrice() const {
 }
 
 QString Trade::getType() const {
-    return type;
+    return QStringLiteral("market");
 }
 
 QString Trade::getPosition() const {
-    return position;
+    return position == TradeSide::Long ? QStringLiteral("long")
+                                       : QStringLiteral("short");
 }
 
 void Trade::setPosition(const QString &position) {
-    this->position = position;
+    this->position = sideFromString(position);
 }
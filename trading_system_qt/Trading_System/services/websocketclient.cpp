@@ -4,19 +4,31 @@
    Socket bridge between the trader’s desktop GUI and the cloud-side
    TradeServer.
 
-     • Sends JSON for “newTrade” and “closeTrade” when TradeManager /
-       DisplayManager raise an event.
+     • Sends “newTrade” and “closeTrade” when TradeManager /
+       DisplayManager raise an event – as WireProtocol binary frames once
+       negotiated, compact JSON otherwise.
      • Parses server push messages, creating/patching local Trade objects,
        and re-emits:
          liveTrade(Trade*, pnl)        – mark-to-market or newly opened
-         closeTradeIncomming(tradeID)  – server confirmed close.
-     • Keeps an in-memory QList<Trade*> so tradeExists(id) can de-dupe
-       duplicates that may arrive during latency spikes.
+         liveTrades(updates)           – one "positions" batch per tick
+         closeTradeIncomming(tradeID)  – server confirmed close
+         orderAck(orderID, tradeID, ok, reason)
+                                       – server risk gate verdict
+         orderThrottled(queued, rej)   – server back-pressure report.
+     • Keeps an in-memory QHash<TradeId, Trade*> so applyTrade() and
+       tradeExists(id) are O(1) look-ups, and de-dupes duplicates that may
+       arrive during latency spikes.
+     • Outgoing orders carry a clientOrderID; the order object is held in
+       pendingOrders until the server's orderAck (which also carries the
+       assigned TradeId) and then released – the filled position arrives
+       in the next "positions" frame.
    ========================================================================= */
 
 #include "websocketclient.h"
 #include "Trading_System/displaymanager.h"
+#include "wireprotocol.h"
 
+#include<QJsonArray>
 #include<QJsonDocument>
 #include<QJsonObject>
 
@@ -27,10 +39,12 @@ WebSocketClient::WebSocketClient(QObject *parent)
     url("ws://trading_cloud:12345/trade")
 {
     connect(webSocket, &QWebSocket::textMessageReceived, this, &WebSocketClient::onTextMessageReceived);
+    connect(webSocket, &QWebSocket::binaryMessageReceived, this, &WebSocketClient::onBinaryMessageReceived);
     connect(webSocket, &QWebSocket::connected, this, &WebSocketClient::onConnected);
     webSocket -> open(QUrl(url));
 }
 WebSocketClient::~WebSocketClient(){
+    qDeleteAll(pendingOrders);
     webSocket->close();
     webSocket->deleteLater();
 }
@@ -49,6 +63,13 @@ void WebSocketClient::onConnected(){
     QJsonObject obj;
     obj["connection"] = "tradeDashboard";
     obj["userID"] = account -> getUserID();
+
+    /* offer binary frames; stay on JSON until the server acks */
+    binaryWire = false;
+    if (qEnvironmentVariable("WIRE_PROTOCOL") != "json") {
+        obj["protocol"] = "binary";
+        obj["protocolVersion"] = Wire::VERSION;
+    }
     QJsonDocument doc(obj);
     webSocket->sendTextMessage(doc.toJson(QJsonDocument::Compact));
 }
@@ -57,51 +78,135 @@ void WebSocketClient::onTextMessageReceived(const QString &message){
     QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
     QJsonObject obj = doc.object();
     QString type = obj["type"].toString();
-    QString tradeID = obj["tradeID"].toString();
-
-    if(!tradeExists(tradeID)){
-        double stopLoss = obj["stopLoss"].toDouble();
-        double takeProfit = obj["takeProfit"].toDouble();
-        double size = obj["size"].toDouble();
-        Asset asset = static_cast<Asset>(obj["asset"].toInt());
-        double openPrice = obj["openPrice"].toDouble();
-        QString position = obj["position"].toString();
 
-        trades.append(new Trade(tradeID, stopLoss, takeProfit, size, asset,openPrice, type, position));
+    if(type == "protocol"){
+        binaryWire = obj["protocol"].toString() == "binary" &&
+                     obj["protocolVersion"].toInt() == Wire::VERSION;
+        return;
     }
-    if(type == "open"){
-        double pnL = obj["pnl"].toDouble();
-        for (Trade *t : trades){
-            if(t->getTradeID()==tradeID){
-                emit liveTrade(t, pnL);
-                break;
-            }
+
+    /* Batched snapshot – every open trade of one asset in a single frame */
+    if(type == "positions"){
+        const QJsonArray arr = obj["trades"].toArray();
+        QList<QPair<Trade*, double>> updates;
+        updates.reserve(arr.size());
+        for (const QJsonValue &v : arr){
+            const QJsonObject t = v.toObject();
+            updates.append({ applyTrade(t, "open"), t["pnl"].toDouble() });
         }
+        if(!updates.isEmpty())
+            emit liveTrades(updates);
+        return;
+    }
+
+    if(type == "throttle"){
+        emit orderThrottled(obj["queued"].toInt(), obj["rejected"].toInt());
+        return;
+    }
+
+    TradeId tradeID = TradeIds::fromString(obj["tradeID"].toString());
+    if(type == "orderAck"){
+        onOrderAck(obj["clientOrderID"].toString().toULongLong(), tradeID,
+                   obj["accepted"].toBool(), obj["reason"].toString());
+    } else if(type == "open"){
+        emit liveTrade(applyTrade(obj, type), obj["pnl"].toDouble());
     } else if(type == "closed"){
-        for (Trade *t : trades){
-            if(t->getTradeID()==tradeID){
-                trades.removeOne(t);
-                emit closeTradeIncomming(tradeID);
-                break;
-            }
-        }
+        if(trades.remove(tradeID))
+            emit closeTradeIncomming(tradeID);
     }
 }
 
-bool WebSocketClient::tradeExists(QString tradeID){
-    for (Trade *t: trades){
-        if(t->getTradeID()==tradeID)
-            return true;
+/* WireProtocol push messages – same events as the JSON path above */
+void WebSocketClient::onBinaryMessageReceived(const QByteArray &frame){
+    Wire::Reader r(frame);
+    if(!r.good()) return;
+
+    if(r.msg() == Wire::Msg::Positions){
+        Wire::Positions m;
+        if(!Wire::decode(r, m)) return;
+        QList<QPair<Trade*, double>> updates;
+        updates.reserve(m.trades.size());
+        for (const Wire::Position &p : m.trades){
+            Trade *t = applyTrade(p.tradeID, p.stopLoss, p.takeProfit, p.size,
+                                  static_cast<Asset>(m.asset), p.openPrice,
+                                  "open", Wire::sideToString(p.side));
+            updates.append({ t, p.pnl });
+        }
+        if(!updates.isEmpty())
+            emit liveTrades(updates);
+    } else if(r.msg() == Wire::Msg::OrderAck){
+        Wire::OrderAck m;
+        if(!Wire::decode(r, m)) return;
+        onOrderAck(m.clientOrderID, m.tradeID, m.accepted, m.reason);
+    } else if(r.msg() == Wire::Msg::Throttle){
+        Wire::Throttle m;
+        if(!Wire::decode(r, m)) return;
+        emit orderThrottled(m.queued, m.rejected);
+    } else if(r.msg() == Wire::Msg::Closed){
+        Wire::Closed m;
+        if(!Wire::decode(r, m)) return;
+        if(trades.remove(m.tradeID))
+            emit closeTradeIncomming(m.tradeID);
     }
-    return false;
+}
+
+/* Server verdict on one of our orders – the local order object is done */
+void WebSocketClient::onOrderAck(quint64 clientOrderID, TradeId tradeID,
+                                 bool accepted, const QString &reason){
+    delete pendingOrders.take(clientOrderID);
+    emit orderAck(clientOrderID, tradeID, accepted, reason);
+}
+
+/* Find the local Trade for obj["tradeID"], creating it on first sight */
+Trade *WebSocketClient::applyTrade(const QJsonObject &obj, const QString &type){
+    return applyTrade(TradeIds::fromString(obj["tradeID"].toString()),
+                      obj["stopLoss"].toDouble(),
+                      obj["takeProfit"].toDouble(),
+                      obj["size"].toDouble(),
+                      static_cast<Asset>(obj["asset"].toInt()),
+                      obj["openPrice"].toDouble(),
+                      type,
+                      obj["position"].toString());
+}
+
+Trade *WebSocketClient::applyTrade(TradeId tradeID, double stopLoss,
+                                   double takeProfit, double size, Asset asset,
+                                   double openPrice, const QString &type,
+                                   const QString &position){
+    Trade *&t = trades[tradeID];
+    if(!t)
+        t = new Trade(tradeID, stopLoss, takeProfit, size, asset,openPrice, type, position);
+    return t;
+}
+
+bool WebSocketClient::tradeExists(TradeId tradeID){
+    return trades.contains(tradeID);
 }
 
 void WebSocketClient::newTrade(Trade *trade){
+    const quint64 clientOrderID = ++lastClientOrderID;
+    pendingOrders.insert(clientOrderID, trade);
+
+    if(binaryWire){
+        Wire::NewTrade m;
+        m.userID        = account->getUserID();
+        m.clientOrderID = clientOrderID;
+        m.asset      = static_cast<int>(trade->getAsset());
+        m.side       = Wire::sideFromString(trade->getPosition());
+        m.orderType  = trade->getType();
+        m.size       = trade->getSize();
+        m.stopLoss   = trade->getStopLoss();
+        m.takeProfit = trade->getTakeProfit();
+        m.openPrice  = trade->getOpenPrice();
+        webSocket->sendBinaryMessage(Wire::encode(m));
+        return;
+    }
+
     QJsonObject obj;
 
     obj["newTrade"] = "newTrade";
     obj["userID"] = account->getUserID();
-    obj["tradeID"] = trade->getTradeID();
+    obj["clientOrderID"] = QString::number(clientOrderID);
     obj["stopLoss"] = trade->getStopLoss();
     obj["takeProfit"] = trade->getTakeProfit();
     obj["size"] = trade->getSize();
@@ -116,11 +221,17 @@ void WebSocketClient::newTrade(Trade *trade){
     webSocket->sendTextMessage(message);
 }
 
-void WebSocketClient::closeTradeOutgoing(QString tradeID){
+void WebSocketClient::closeTradeOutgoing(TradeId tradeID){
+    if(binaryWire){
+        webSocket->sendBinaryMessage(
+            Wire::encode(Wire::CloseTrade{ account->getUserID(), tradeID }));
+        return;
+    }
+
     QJsonObject obj;
     obj["closeTrade"] = "closeTrade";
     obj["userID"] = account->getUserID();
-    obj["tradeID"] = tradeID;
+    obj["tradeID"] = TradeIds::toString(tradeID);
 
 
     QJsonDocument doc(obj);
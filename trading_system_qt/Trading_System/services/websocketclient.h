@@ -7,13 +7,21 @@
      • Sends JSON commands for “newTrade” and “closeTrade”.
      • Parses server push messages and re-emits:
          liveTrade(Trade*, pnl)        – new or updated position
+         liveTrades(updates)           – batched "positions" snapshot
          closeTradeIncomming(tradeID)  – server confirmed close
+         orderAck(orderID, tradeID, ok, reason)
+                                       – server risk gate accepted /
+                                         rejected an order
+         orderThrottled(queued, rej)   – server is rate‑limiting orders
      • tradeExists(id) lets higher layers ignore duplicate requests while
-       awaiting confirmation.
+       awaiting confirmation; trades are keyed by their 64‑bit TradeId.
 
    Design notes
      • onConnected() performs the user-ID handshake right after the WS
-       upgrade so the server knows which account this socket serves.
+       upgrade so the server knows which account this socket serves. It
+       also offers the binary WireProtocol; once the server acks, orders
+       go out and snapshots come in as binary frames ($WIRE_PROTOCOL=json
+       keeps the socket on JSON).
      • All risk checks, file I/O, and GUI updates live in higher layers;
        this class is transport-only.
      • TODO – migrate to wss:// and add JWT authentication before public
@@ -27,6 +35,10 @@
 #include "trademanager.h"
 
 #include <QObject>
+#include <QJsonObject>
+#include <QHash>
+#include <QList>
+#include <QPair>
 
 class DisplayManager;
 
@@ -36,27 +48,43 @@ class WebSocketClient : public QObject
 public:
     explicit WebSocketClient(QObject *parent = nullptr);
     ~WebSocketClient();
-    bool tradeExists(QString tradeID);
+    bool tradeExists(TradeId tradeID);
     void setDisplayManager(DisplayManager* displayManager);
     void setTradeManager(TradeManager* tradeManager);
 
 signals:
     void liveTrade(Trade* trade, double pnL);
-    void closeTradeIncomming(QString TradeID);
+    void liveTrades(const QList<QPair<Trade*, double>> &updates);
+    void closeTradeIncomming(TradeId tradeID);
+    void orderAck(quint64 clientOrderID, TradeId tradeID, bool accepted,
+                  QString reason);
+    void orderThrottled(int queued, int rejected);
 
 private slots:
     void onTextMessageReceived(const QString &message);
+    void onBinaryMessageReceived(const QByteArray &frame);
     void onConnected();
     void newTrade(Trade *trade);
-    void closeTradeOutgoing(QString tradeID);
+    void closeTradeOutgoing(TradeId tradeID);
 
 private:
+    Trade *applyTrade(const QJsonObject &obj, const QString &type);
+    void   onOrderAck(quint64 clientOrderID, TradeId tradeID, bool accepted,
+                      const QString &reason);
+    Trade *applyTrade(TradeId tradeID, double stopLoss,
+                      double takeProfit, double size, Asset asset,
+                      double openPrice, const QString &type,
+                      const QString &position);
+
     QWebSocket *webSocket;
     Account *account;
-    QList<Trade*> trades;
+    QHash<TradeId, Trade*> trades;          // filled positions by ID
+    QHash<quint64, Trade*> pendingOrders;   // clientOrderID → unacked order
+    quint64 lastClientOrderID {0};
     TradeManager *tradeManager;
     DisplayManager *displayManager;
     QString url;
+    bool binaryWire {false};   // server acked WireProtocol for this socket
 };
 
 #endif // WEBSOCKETCLIENT_H
@@ -47,6 +47,12 @@ HEADERS += \
     Charting_System/timeframe.h \
     Charting_System/chartwidget.h \
     Chat_AI/chataiwidget.h \
+    Common/services/exchangeendpoints.h \
+    Common/services/klinedecoder.h \
+    Common/services/marketcapture.h \
+    Common/services/objectpool.h \
+    Common/services/tradeid.h \
+    Common/services/wireprotocol.h \
     DatabaseManager.h \
     Trading_System/displaymanager.h \
     Trading_System/executionwidget.h \